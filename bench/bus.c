@@ -0,0 +1,399 @@
+/*
+ *           :  bus.c
+ *
+ *      :      LcdUpdate,    (LCD_TRANSPORT == LCD_TR_SIM).
+ *                      :    , 
+ *                 ( SCE)    DC (   DC    ).
+ *                    -    ,     1.0:
+ *                 LcdSend    SCE   DC   ,  LcdUpdate 
+ *                        (LegacyUpdate ).
+ *                         ( Costs)   
+ *                            ,   
+ *                  LCD_TR_HWSPI   2 (     README).  ,   :
+ *                        ,    .
+ *                   : bench/run.sh
+ *
+ *         :  XANDER
+ * - :  http://we.easyelectronics.ru/profile/XANDER/
+ *
+ *      :  GPL v3.0
+ *
+ *    :  GCC
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "n3310.h"
+#include "n3310_tr.h"
+#include "n3310_sim.h"
+#include "picture.h"
+
+//  
+typedef struct
+{
+    const char  *name;           // 
+    void       (*draw)( void );  //     
+    int          lo;             //       ,
+    int          hi;             //        1.0
+
+} Scene;
+
+//   
+typedef struct
+{
+    unsigned long  data;         //  
+    unsigned long  cmd;          //  
+    unsigned long  ce;           //  ( SCE)
+    unsigned long  dc;           //   DC
+    unsigned long  writes;       //  LcdTrWrite
+
+} Traffic;
+
+//     
+typedef struct
+{
+    const char  *name;           //  
+    byte         legacy;         // TRUE -    1.0
+    byte         overlap;        // TRUE -         
+    int          wire;           //     : 8  *  SCK
+    int          work;           //     :  , ,  
+    int          sync;           //   ,      (   )
+    int          call;           //    LcdTrWrite
+    int          ce;             //    (LcdTrBegin  LcdTrEnd)
+    int          dc;             //    DC
+
+} Cost;
+
+//   
+
+static void DrawFrame    ( void );
+static void DrawDigit    ( void );
+static void DrawBar      ( void );
+static void DrawCorners  ( void );
+static void Measure      ( const Scene *scene, Traffic *now, Traffic *old );
+static void Counters     ( Traffic *t, unsigned long dcWrites );
+static void LegacyUpdate ( int lo, int hi );
+static void LegacySend   ( byte data, LcdCmdData cd );
+static void Print        ( const char *name, const Traffic *t );
+static void PrintCosts   ( const Traffic *now, const Traffic *old );
+static long Cycles       ( const Cost *cost, const Traffic *t );
+
+//  
+
+#define SCENES             ( sizeof( Scenes ) / sizeof( Scenes[0] ) )
+
+static const Scene Scenes [] =
+{
+    { "  (LcdImage)",      DrawFrame,   0,                    LCD_CACHE_SIZE - 1 },
+    { " 6x8 (LcdChr)",          DrawDigit,   2 * LCD_X_RES + 36,   2 * LCD_X_RES + 41 },
+    { " 4x20 (LcdSingleBar)", DrawBar,     2 * LCD_X_RES + 40,   4 * LCD_X_RES + 43 },
+    { "   ",           DrawCorners, 0,                    LCD_CACHE_SIZE - 1 }
+};
+
+//    LCD_TR_HWSPI.  1.0     LcdSend: , SCE, DC,
+//  SPDR,  SPIF, SCE ,         -  30 
+//  8 * . LcdTrWrite   ( ,  SPIF     SPDR)
+//   10        4   SPDR  . 
+// LcdTrWrite (n3310_spi.c)    10 ,     .
+// LCD_TR_SOFT (n3310_soft.c)    :  8     8  ,  .
+// LCD_TR_USART (n3310_usart.c)     UDR0,   18    
+// ( UDRE0,  UDR0,  TXC0)    ,    16 * ( UBRR + 1 ) 
+static const Cost Costs [] =
+{
+    { "HWSPI /2, v1.0",            TRUE,  FALSE,   16, 30, 0,  0,  0,  0 },
+    { "HWSPI /2,  ",   FALSE, FALSE,   16, 10, 4, 20, 20, 12 },
+    { "HWSPI /2",                  FALSE, TRUE,    16, 10, 4, 20, 20, 12 },
+    { "HWSPI /4, v1.0",            TRUE,  FALSE,   32, 30, 0,  0,  0,  0 },
+    { "HWSPI /4,  ",   FALSE, FALSE,   32, 10, 4, 20, 20, 12 },
+    { "HWSPI /4",                  FALSE, TRUE,    32, 10, 4, 20, 20, 12 },
+    { "HWSPI /8, v1.0",            TRUE,  FALSE,   64, 30, 0,  0,  0,  0 },
+    { "HWSPI /8,  ",   FALSE, FALSE,   64, 10, 4, 20, 20, 12 },
+    { "HWSPI /8",                  FALSE, TRUE,    64, 10, 4, 20, 20, 12 },
+    { "HWSPI /16, v1.0",           TRUE,  FALSE,  128, 30, 0,  0,  0,  0 },
+    { "HWSPI /16,  ",  FALSE, FALSE,  128, 10, 4, 20, 20, 12 },
+    { "HWSPI /16",                 FALSE, TRUE,   128, 10, 4, 20, 20, 12 },
+    { "HWSPI /32, v1.0",           TRUE,  FALSE,  256, 30, 0,  0,  0,  0 },
+    { "HWSPI /32,  ",  FALSE, FALSE,  256, 10, 4, 20, 20, 12 },
+    { "HWSPI /32",                 FALSE, TRUE,   256, 10, 4, 20, 20, 12 },
+    { "HWSPI /64, v1.0",           TRUE,  FALSE,  512, 30, 0,  0,  0,  0 },
+    { "HWSPI /64,  ",  FALSE, FALSE,  512, 10, 4, 20, 20, 12 },
+    { "HWSPI /64",                 FALSE, TRUE,   512, 10, 4, 20, 20, 12 },
+    { "HWSPI /128, v1.0",          TRUE,  FALSE, 1024, 30, 0,  0,  0,  0 },
+    { "HWSPI /128,  ", FALSE, FALSE, 1024, 10, 4, 20, 20, 12 },
+    { "HWSPI /128",                FALSE, TRUE,  1024, 10, 4, 20, 20, 12 },
+    { "USART UBRR 0",              FALSE, TRUE,    16, 18, 0, 20, 20, 12 },
+    { "USART UBRR 1",              FALSE, TRUE,    32, 18, 0, 20, 20, 12 },
+    { "USART UBRR 3",              FALSE, TRUE,    64, 18, 0, 20, 20, 12 },
+    { "SOFT",                      FALSE, FALSE,    0, 72, 0, 20, 20, 12 }
+};
+
+//  Costs,     
+#define COST_REF           "HWSPI /2"
+
+#define COSTS              ( sizeof( Costs ) / sizeof( Costs[0] ) )
+
+//        
+#define BENCH_F_CPU        8000000L
+
+//   DC  LegacyUpdate
+static unsigned long  LegacyDc;
+
+
+
+int main ( void )
+{
+    Traffic  now, old;
+    unsigned i;
+
+#ifdef CHINA_LCD
+    printf( "==   (CHINA_LCD)\n" );
+#else
+    printf( "==  PCD8544\n" );
+#endif
+
+    LcdInit();
+
+    printf( "%-30s %8s %8s %8s %8s\n", "", "", "", "SCE", "DC" );
+
+    for ( i = 0; i < SCENES; i++ )
+    {
+        Measure( &Scenes[i], &now, &old );
+
+        Print( Scenes[i].name, &now );
+        Print( "   1.0", &old );
+    }
+
+    for ( i = 0; i < SCENES; i++ )
+    {
+        Measure( &Scenes[i], &now, &old );
+
+        printf( "\n%s,   F_CPU = %ld \n", Scenes[i].name, BENCH_F_CPU / 1000000L );
+        PrintCosts( &now, &old );
+    }
+
+    return 0;
+}
+
+
+
+/*
+ *                    :  Measure
+ *               :          LcdUpdate,
+ *                                1.0    
+ * ()           :  scene -> 
+ *                          now   ->   LcdUpdate
+ *                          old   ->  LegacyUpdate
+ *   :  
+ */
+static void Measure ( const Scene *scene, Traffic *now, Traffic *old )
+{
+    LcdClear();
+    LcdUpdate();
+
+    scene->draw();
+
+    LcdSimResetCounters();
+    LcdUpdate();
+    Counters( now, LcdSimState()->dcSwitches );
+
+    //      ,     
+    LcdSimResetCounters();
+    LegacyDc = 0;
+    LegacyUpdate( scene->lo, scene->hi );
+    Counters( old, LegacyDc );
+}
+
+
+
+/*
+ *                    :  Counters
+ *               :      Traffic
+ * ()           :  t        ->  
+ *                          dcWrites ->    DC
+ *   :  
+ */
+static void Counters ( Traffic *t, unsigned long dcWrites )
+{
+    const LcdSimModel *sim = LcdSimState();
+
+    t->data   = sim->dataBytes;
+    t->cmd    = sim->cmdBytes;
+    t->ce     = sim->ceCycles;
+    t->dc     = dcWrites;
+    t->writes = sim->trWrites;
+}
+
+
+
+/*
+ *                    :  LegacyUpdate
+ *               :  LcdUpdate  1.0:    lo  hi,   .
+ *                              ,      LcdUpdate
+ * ()           :  lo ->     
+ *                          hi ->     
+ *   :  
+ */
+static void LegacyUpdate ( int lo, int hi )
+{
+    const LcdSimModel *sim = LcdSimState();
+    int  i;
+
+    #ifdef CHINA_LCD
+
+        byte x,y;
+
+        x = lo % LCD_X_RES;
+        LegacySend( 0x80 | x, LCD_CMD );
+
+        y = lo / LCD_X_RES + 1;
+        LegacySend( 0x40 | y, LCD_CMD );
+
+        for ( i = lo; i <= hi; i++ )
+        {
+            LegacySend( sim->ram[ i / LCD_X_RES + SIM_Y_OFFSET ][ i % LCD_X_RES ], LCD_DATA );
+
+            x++;
+            if ( x >= LCD_X_RES )
+            {
+                x=0;
+                LegacySend( 0x80, LCD_CMD );
+                y++;
+                LegacySend( 0x40 | y, LCD_CMD );
+            }
+        }
+
+        LegacySend( 0x21, LCD_CMD );
+        LegacySend( 0x45, LCD_CMD );
+        LegacySend( 0x20, LCD_CMD );
+
+    #else
+
+        LegacySend( 0x80 | ( lo % LCD_X_RES ), LCD_CMD );
+        LegacySend( 0x40 | ( lo / LCD_X_RES ), LCD_CMD );
+
+        for ( i = lo; i <= hi; i++ )
+        {
+            LegacySend( sim->ram[ i / LCD_X_RES + SIM_Y_OFFSET ][ i % LCD_X_RES ], LCD_DATA );
+        }
+
+    #endif
+}
+
+
+
+/*
+ *                    :  LegacySend
+ *               :  LcdSend  1.0: SCE      , DC  
+ * ()           :  data ->   
+ *                          cd   ->    ( enum  n3310.h)
+ *   :  
+ */
+static void LegacySend ( byte data, LcdCmdData cd )
+{
+    LcdTrBegin();
+    LcdTrWrite( &data, 1, cd );
+    LcdTrEnd();
+
+    LegacyDc++;
+}
+
+
+
+/*
+ *                    :  Print
+ *               :    
+ * ()           :  name ->  
+ *                          t    -> 
+ *   :  
+ */
+static void Print ( const char *name, const Traffic *t )
+{
+    printf( "%-30s %8lu %8lu %8lu %8lu\n", name, t->data, t->cmd, t->ce, t->dc );
+}
+
+
+
+/*
+ *                    :  PrintCosts
+ *               :           Costs
+ * ()           :  now ->   LcdUpdate
+ *                          old ->  LegacyUpdate
+ *   :  
+ */
+static void PrintCosts ( const Traffic *now, const Traffic *old )
+{
+    const Traffic *t;
+    long      cycles;
+    long      ref = 0;
+    unsigned  i;
+
+    for ( i = 0; i < COSTS; i++ )
+    {
+        if ( strcmp( Costs[i].name, COST_REF ) == 0 ) ref = Cycles( &Costs[i], now );
+    }
+
+    printf( "%-26s %10s %10s %10s %6s\n", "", "", "", "/", "." );
+
+    for ( i = 0; i < COSTS; i++ )
+    {
+        t = Costs[i].legacy ? old : now;
+        cycles = Cycles( &Costs[i], t );
+
+        printf( "%-26s %10ld %10ld %10ld %6.1f\n", Costs[i].name, cycles,
+                cycles / ( BENCH_F_CPU / 1000000L ),
+                (long)( (double)t->data * BENCH_F_CPU / cycles ),
+                (double)cycles / ref );
+    }
+}
+
+
+
+/*
+ *                    :  Cycles
+ *               :         .    
+ *                           ,   max( wire, work ) + sync,  wire + work + sync
+ * ()           :  cost ->  
+ *                          t    ->  
+ *   :   
+ */
+static long Cycles ( const Cost *cost, const Traffic *t )
+{
+    long perByte;
+
+    if ( cost->overlap )
+        perByte = ( cost->wire > cost->work ? cost->wire : cost->work ) + cost->sync;
+    else
+        perByte = cost->wire + cost->work + cost->sync;
+
+    return perByte * (long)( t->data + t->cmd )
+         + (long)cost->call * t->writes
+         + (long)cost->ce * t->ce
+         + (long)cost->dc * t->dc;
+}
+
+
+
+// 
+
+static void DrawFrame ( void )
+{
+    LcdImage( Picture );
+}
+
+static void DrawDigit ( void )
+{
+    LcdGotoXYFont( 6, 2 );
+    LcdChr( FONT_1X, '5' );
+}
+
+static void DrawBar ( void )
+{
+    LcdSingleBar( 40, 35, 20, 4, PIXEL_ON );
+}
+
+static void DrawCorners ( void )
+{
+    LcdPixel( 0, 0, PIXEL_ON );
+    LcdPixel( LCD_X_RES - 1, LCD_Y_RES - 1, PIXEL_ON );
+}
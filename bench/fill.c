@@ -0,0 +1,237 @@
+/*
+ *           :  fill.c
+ *
+ *      :       LcdFillRect  LcdSingleBar ( , LcdBox)
+ *                    (LCD_TRANSPORT == LCD_TR_SIM).
+ *                     ,       ,
+ *                      ,    LcdUpdate 
+ *                       ,    .
+ *                             LcdPixel,
+ *                  LcdSingleBar    1.0.      .
+ *                   : bench/run.sh
+ *
+ *         :  XANDER
+ * - :  http://we.easyelectronics.ru/profile/XANDER/
+ *
+ *      :  GPL v3.0
+ *
+ *    :  GCC
+ */
+
+#define _POSIX_C_SOURCE  199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "n3310.h"
+#include "n3310_sim.h"
+
+//     + 
+#define CHECKS             20000
+
+//     
+#define RUNS               20000
+
+//   
+
+static byte   RefBox     ( int x1, int y1, int x2, int y2, LcdPixelMode mode );
+static int    Compare    ( void );
+static void   PixelBox   ( int x1, int y1, int x2, int y2, LcdPixelMode mode );
+static double Now        ( void );
+static void   Time       ( const char *name, int x1, int y1, int x2, int y2, LcdPixelMode mode );
+
+//  
+
+// :  ,    
+static byte  Ref [ LCD_Y_RES ][ LCD_X_RES ];
+
+
+
+int main ( void )
+{
+    int   i, x1, y1, x2, y2, h, w;
+    int   fails = 0;
+    byte  mode, ret, ref;
+
+#ifdef CHINA_LCD
+    printf( "==   (CHINA_LCD)\n" );
+#else
+    printf( "==  PCD8544\n" );
+#endif
+
+    LcdInit();
+    srand( 1 );
+
+    for ( i = 0; i < CHECKS; i++ )
+    {
+        //      ,   
+        x1 = rand() % ( LCD_X_RES + 20 ) - 10;
+        y1 = rand() % ( LCD_Y_RES + 20 ) - 10;
+        x2 = rand() % ( LCD_X_RES + 20 ) - 10;
+        y2 = rand() % ( LCD_Y_RES + 20 ) - 10;
+        mode = rand() % 3;
+
+        ret = LcdFillRect( x1, y1, x2, y2, mode );
+        ref = RefBox( x1, y1, x2, y2, mode );
+
+        if ( ret != ref ) fails++;
+
+        // :   ,   
+        x1 = rand() % ( LCD_X_RES + 10 ) - 5;
+        y1 = rand() % ( LCD_Y_RES + 10 ) - 5;
+        h  = rand() % 64;
+        w  = rand() % 48;
+        mode = rand() % 3;
+
+        ret = LcdSingleBar( x1, y1, h, w, mode );
+        ref = ( h == 0 || w == 0 ) ? OK : RefBox( x1, y1 - h + 1, x1 + w - 1, y1, mode );
+
+        if ( ret != ref ) fails++;
+
+        LcdUpdate();
+        fails += Compare();
+    }
+
+    printf( "   : %d,   : %d\n", 2 * CHECKS, fails );
+
+    printf( "%-28s %12s %12s %8s\n", "   ", "LcdPixel, ", "LcdBox, ", "." );
+
+    Time( " 20x40, PIXEL_XOR", 10, 6, 29, 45, PIXEL_XOR );
+    Time( " 20x40, PIXEL_ON",  10, 6, 29, 45, PIXEL_ON );
+    Time( " , PIXEL_ON",   0, 0, LCD_X_RES - 1, LCD_Y_RES - 1, PIXEL_ON );
+    Time( " 84x1, PIXEL_XOR",   0, 21, LCD_X_RES - 1, 21, PIXEL_XOR );
+    Time( " 6x8  y = 3, OFF",  30, 3, 35, 10, PIXEL_OFF );
+
+    return fails != 0;
+}
+
+
+
+/*
+ *                    :  RefBox
+ *               :  :       
+ * ()           :  x1, y1 ->  
+ *                          x2, y2 ->  
+ *                          mode   -> Off, On  Xor.  enum  n3310.h
+ *   :  OK    ,  OUT_OF_BORDER
+ */
+static byte RefBox ( int x1, int y1, int x2, int y2, LcdPixelMode mode )
+{
+    int  x, y, tmp;
+    byte response = OK;
+
+    if ( x1 > x2 ) { tmp = x1; x1 = x2; x2 = tmp; }
+    if ( y1 > y2 ) { tmp = y1; y1 = y2; y2 = tmp; }
+
+    for ( y = y1; y <= y2; y++ )
+    {
+        for ( x = x1; x <= x2; x++ )
+        {
+            if ( x < 0 || x >= LCD_X_RES || y < 0 || y >= LCD_Y_RES )
+            {
+                response = OUT_OF_BORDER;
+                continue;
+            }
+
+            if ( mode == PIXEL_ON )
+                Ref[y][x] = 1;
+            else if ( mode == PIXEL_OFF )
+                Ref[y][x] = 0;
+            else
+                Ref[y][x] ^= 1;
+        }
+    }
+
+    return response;
+}
+
+
+
+/*
+ *                    :  Compare
+ *               :       
+ * ()           :  
+ *   :  1   ,  0
+ */
+static int Compare ( void )
+{
+    byte x, y;
+
+    for ( y = 0; y < LCD_Y_RES; y++ )
+    {
+        for ( x = 0; x < LCD_X_RES; x++ )
+        {
+            if ( LcdSimPixel( x, y ) != Ref[y][x] ) return 1;
+        }
+    }
+
+    return 0;
+}
+
+
+
+/*
+ *                    :  PixelBox
+ *               :    ,   LcdSingleBar  1.0
+ * ()           :  x1, y1 ->   
+ *                          x2, y2 ->   
+ *                          mode   -> Off, On  Xor.  enum  n3310.h
+ *   :  
+ */
+static void PixelBox ( int x1, int y1, int x2, int y2, LcdPixelMode mode )
+{
+    int x, y;
+
+    for ( y = y1; y <= y2; y++ )
+    {
+        for ( x = x1; x <= x2; x++ )
+        {
+            LcdPixel( x, y, mode );
+        }
+    }
+}
+
+
+
+/*
+ *                    :  Now
+ *               :   
+ * ()           :  
+ *   :    
+ */
+static double Now ( void )
+{
+    struct timespec ts;
+
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+
+
+/*
+ *                    :  Time
+ *               :       PixelBox  LcdFillRect  
+ * ()           :  name   ->  
+ *                          x1, y1 ->   
+ *                          x2, y2 ->   
+ *                          mode   -> Off, On  Xor.  enum  n3310.h
+ *   :  
+ */
+static void Time ( const char *name, int x1, int y1, int x2, int y2, LcdPixelMode mode )
+{
+    double t, pixel, box;
+    int    i;
+
+    t = Now();
+    for ( i = 0; i < RUNS; i++ ) PixelBox( x1, y1, x2, y2, mode );
+    pixel = ( Now() - t ) / RUNS;
+
+    t = Now();
+    for ( i = 0; i < RUNS; i++ ) LcdFillRect( x1, y1, x2, y2, mode );
+    box = ( Now() - t ) / RUNS;
+
+    printf( "%-28s %12.1f %12.1f %7.0fx\n", name, pixel, box, pixel / box );
+}
@@ -0,0 +1,347 @@
+/*
+ *           :  flood.c
+ *
+ *      :     LcdFloodFill    (LCD_TRANSPORT == LCD_TR_SIM).
+ *                   LCD_FLOOD_STATS,      (LcdFloodPeak).
+ *                              
+ *                 .   :   ,    
+ *                  .       -   
+ *                    .   ,    ,
+ *                   (OUT_OF_MEMORY) -       .
+ *                      ,     - .
+ *                   : bench/run.sh
+ *
+ *         :  XANDER
+ * - :  http://we.easyelectronics.ru/profile/XANDER/
+ *
+ *      :  GPL v3.0
+ *
+ *    :  GCC
+ */
+
+#define _POSIX_C_SOURCE  199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "n3310.h"
+#include "n3310_sim.h"
+
+#ifndef LCD_FLOOD_STATS
+    #error "bench/flood.c   LCD_FLOOD_STATS ( bench/run.sh)"
+#endif
+
+//     
+#define SCENES             20000
+
+//     
+#define RUNS               2000
+
+//   
+
+static void   DrawEmpty  ( void );
+static void   DrawComb   ( void );
+static void   DrawCircle ( void );
+static void   DrawIcon   ( void );
+static void   DrawNoise  ( void );
+static void   Time       ( const char *name, void ( *draw )( void ), int x, int y );
+static void   Check      ( const char *name, void ( *draw )( void ) );
+static void   Snapshot   ( byte screen[ LCD_Y_RES ][ LCD_X_RES ] );
+static long   Reference  ( int x, int y, LcdPixelMode mode );
+static double Now        ( void );
+
+//  
+
+//     ,     LcdFloodFill
+static byte  Before [ LCD_Y_RES ][ LCD_X_RES ];
+static byte  Expect [ LCD_Y_RES ][ LCD_X_RES ];
+static byte  After  [ LCD_Y_RES ][ LCD_X_RES ];
+
+//    
+static byte  QueueX [ LCD_X_RES * LCD_Y_RES ];
+static byte  QueueY [ LCD_X_RES * LCD_Y_RES ];
+
+//      
+static int   Fails;
+
+
+
+int main ( void )
+{
+    printf( "== LCD_FLOOD_STACK = %d\n", LCD_FLOOD_STACK );
+
+    LcdInit();
+    srand( 1 );
+
+    printf( "%-30s %8s %8s %10s %8s %8s\n", "", "", "", "", "/", "" );
+
+    Time( " ",              DrawEmpty,  41, 23 );
+    Time( "  41 ",        DrawComb,   0, 0 );
+    Time( "  20",            DrawCircle, 41, 23 );
+
+    printf( "\n%-30s %8s %8s %8s %8s %8s\n", " ", "<=8", "<=16", ".", "", "" );
+
+    Check( " (, )", DrawIcon );
+    Check( " 5..45%",                 DrawNoise );
+
+    return Fails != 0;
+}
+
+
+
+/*
+ *                    :  Time
+ *               :    ,    ,      .
+ *                               ,     LcdFloodFill
+ * ()           :  name ->  
+ *                          draw ->  
+ *                          x, y ->   
+ *   :  
+ */
+static void Time ( const char *name, void ( *draw )( void ), int x, int y )
+{
+    double t, total = 0;
+    long   pixels, filled = 0;
+    int    i;
+    byte   ret = OK;
+
+    LcdClear();
+    draw();
+    LcdUpdate();
+    Snapshot( Before );
+    pixels = Reference( x, y, PIXEL_ON );
+
+    for ( i = 0; i < RUNS; i++ )
+    {
+        LcdClear();
+        draw();
+
+        t = Now();
+        ret = LcdFloodFill( x, y, PIXEL_ON );
+        total += Now() - t;
+    }
+
+    total /= RUNS;
+
+    //      :    ,   
+    LcdUpdate();
+    Snapshot( After );
+
+    for ( y = 0; y < LCD_Y_RES; y++ )
+        for ( x = 0; x < LCD_X_RES; x++ )
+            if ( After[y][x] != Before[y][x] ) filled++;
+
+    printf( "%-30s %8ld %8ld %10.2f %8.0f %8d%s\n", name, pixels, filled, total / 1000, filled * 1000 / total,
+            LcdFloodPeak(), ( ret == OUT_OF_MEMORY ) ? "  OUT_OF_MEMORY" : "" );
+}
+
+
+
+/*
+ *                    :  Check
+ *               :           
+ *                            .    ,  ,
+ *                             ,     
+ * ()           :  name ->  
+ *                          draw ->   
+ *   :  
+ */
+static void Check ( const char *name, void ( *draw )( void ) )
+{
+    int   i, x, y, peak, worst = 0, upto8 = 0, upto16 = 0, full = 0, fails = 0;
+    byte  mode, ret;
+
+    for ( i = 0; i < SCENES; i++ )
+    {
+        LcdClear();
+        draw();
+        LcdUpdate();
+        Snapshot( Before );
+
+        x = rand() % LCD_X_RES;
+        y = rand() % LCD_Y_RES;
+        mode = rand() % 3;
+
+        Reference( x, y, mode );
+
+        ret = LcdFloodFill( x, y, mode );
+        peak = LcdFloodPeak();
+        LcdUpdate();
+        Snapshot( After );
+
+        if ( peak <= 8 ) upto8++;
+        if ( peak <= 16 ) upto16++;
+        if ( peak > worst ) worst = peak;
+
+        if ( ret == OUT_OF_MEMORY )
+        {
+            full++;
+
+            //   ,     
+            for ( y = 0; y < LCD_Y_RES; y++ )
+                for ( x = 0; x < LCD_X_RES; x++ )
+                    if ( After[y][x] != Before[y][x] && After[y][x] != Expect[y][x] ) { fails++; y = LCD_Y_RES; break; }
+        }
+        else if ( ret != OK || memcmp( After, Expect, sizeof( After ) ) != 0 )
+        {
+            fails++;
+        }
+    }
+
+    printf( "%-30s %7.1f%% %7.1f%% %8d %7.1f%% %8d\n", name, 100.0 * upto8 / SCENES, 100.0 * upto16 / SCENES,
+            worst, 100.0 * full / SCENES, fails );
+
+    Fails += fails;
+}
+
+
+
+/*
+ *                    :  Snapshot
+ *               :     
+ * ()           :  screen ->  
+ *   :  
+ */
+static void Snapshot ( byte screen[ LCD_Y_RES ][ LCD_X_RES ] )
+{
+    byte x, y;
+
+    for ( y = 0; y < LCD_Y_RES; y++ )
+        for ( x = 0; x < LCD_X_RES; x++ )
+            screen[y][x] = LcdSimPixel( x, y );
+}
+
+
+
+/*
+ *                    :  Reference
+ *               :        Before: 4-    x, y.
+ *                             Expect
+ * ()           :  x, y ->   
+ *                          mode -> Off, On  Xor.  enum  n3310.h
+ *   :    
+ */
+static long Reference ( int x, int y, LcdPixelMode mode )
+{
+    static const signed char  stepX [4] = { 1, -1, 0, 0 };
+    static const signed char  stepY [4] = { 0, 0, 1, -1 };
+
+    byte  target, color;
+    byte  seen [ LCD_Y_RES ][ LCD_X_RES ];
+    int   head = 0, tail = 0, d, nx, ny;
+
+    memcpy( Expect, Before, sizeof( Expect ) );
+    memset( seen, 0x00, sizeof( seen ) );
+
+    target = Before[y][x];
+
+    if ( ( mode == PIXEL_ON && target ) || ( mode == PIXEL_OFF && !target ) ) return 0;
+
+    color = ( mode == PIXEL_XOR ) ? !target : ( mode == PIXEL_ON );
+
+    QueueX[ tail ] = x;
+    QueueY[ tail ] = y;
+    tail++;
+    seen[y][x] = TRUE;
+
+    while ( head < tail )
+    {
+        x = QueueX[ head ];
+        y = QueueY[ head ];
+        head++;
+
+        Expect[y][x] = color;
+
+        for ( d = 0; d < 4; d++ )
+        {
+            nx = x + stepX[d];
+            ny = y + stepY[d];
+
+            if ( nx < 0 || nx >= LCD_X_RES || ny < 0 || ny >= LCD_Y_RES ) continue;
+            if ( seen[ny][nx] || Before[ny][nx] != target ) continue;
+
+            seen[ny][nx] = TRUE;
+            QueueX[ tail ] = nx;
+            QueueY[ tail ] = ny;
+            tail++;
+        }
+    }
+
+    return tail;
+}
+
+
+
+/*
+ *                    :  Now
+ *               :   
+ * ()           :  
+ *   :    
+ */
+static double Now ( void )
+{
+    struct timespec ts;
+
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+
+
+// 
+
+static void DrawEmpty ( void )
+{
+}
+
+static void DrawComb ( void )
+{
+    int x;
+
+    //    :     -    
+    for ( x = 1; x < LCD_X_RES - 1; x += 2 )
+        LcdVLine( x, 1, LCD_Y_RES - 3, PIXEL_ON );
+}
+
+static void DrawCircle ( void )
+{
+    LcdCircle( 41, 23, 20, PIXEL_ON );
+}
+
+static void DrawIcon ( void )
+{
+    int i, n;
+
+    n = 1 + rand() % 8;
+    for ( i = 0; i < n; i++ )
+        LcdCircle( rand() % LCD_X_RES, rand() % LCD_Y_RES, rand() % 30, PIXEL_ON );
+
+    n = rand() % 8;
+    for ( i = 0; i < n; i++ )
+        LcdLine( rand() % LCD_X_RES, rand() % LCD_Y_RES, rand() % LCD_X_RES, rand() % LCD_Y_RES, PIXEL_ON );
+
+    n = rand() % 4;
+    for ( i = 0; i < n; i++ )
+        LcdRect( rand() % LCD_X_RES, rand() % LCD_Y_RES, rand() % LCD_X_RES, rand() % LCD_Y_RES, PIXEL_ON );
+}
+
+static void DrawNoise ( void )
+{
+    static byte  noise [ LCD_CACHE_SIZE ];
+    int   i, b, density;
+
+    density = 5 + rand() % 41;
+
+    for ( i = 0; i < LCD_CACHE_SIZE; i++ )
+    {
+        noise[i] = 0;
+
+        for ( b = 0; b < 8; b++ )
+            if ( rand() % 100 < density ) noise[i] |= 1 << b;
+    }
+
+    LcdBlit( noise, LCD_X_RES, LCD_Y_RES, 0, 0, ROP_COPY, NULL );
+}
@@ -0,0 +1,162 @@
+/*
+ *           :  linux.c
+ *
+ *      :     LCD_TR_LINUX   LcdUpdate  LcdContrast.
+ *                   LCD_LINUX_FAKE:  spidev  gpiochip    
+ *                   (n3310_sim.c),   LcdLinuxGetStats   ioctl
+ *                  ,    .     
+ *                 SPI_IOC_MESSAGE    GPIO,   spidev,    ,
+ *                   .         .
+ *                   : bench/run.sh
+ *
+ *         :  XANDER
+ * - :  http://we.easyelectronics.ru/profile/XANDER/
+ *
+ *      :  GPL v3.0
+ *
+ *    :  GCC
+ */
+
+#include <stdio.h>
+
+#include "n3310.h"
+#include "n3310_linux.h"
+#include "n3310_sim.h"
+#include "picture.h"
+
+#if LCD_TRANSPORT != LCD_TR_LINUX || !defined( LCD_LINUX_FAKE )
+    #error "bench/linux.c   LCD_TR_LINUX  LCD_LINUX_FAKE ( bench/run.sh)"
+#endif
+
+// 
+typedef struct
+{
+    const char  *name;           // 
+    void       (*draw)( void );  //      ( )
+    void       (*send)( void );  //  
+
+} Scene;
+
+//   
+
+static void DrawFrame   ( void );
+static void DrawDigit   ( void );
+static void DrawBar     ( void );
+static void DrawNothing ( void );
+static void SendUpdate  ( void );
+static void SendContrast( void );
+static int  Compare     ( const byte *image );
+
+//  
+
+#define SCENES             ( sizeof( Scenes ) / sizeof( Scenes[0] ) )
+
+static const Scene Scenes [] =
+{
+    { "  (LcdImage)",      DrawFrame,   SendUpdate },
+    { " 6x8 (LcdChr)",          DrawDigit,   SendUpdate },
+    { " 4x20 (LcdSingleBar)", DrawBar,     SendUpdate },
+    { " ",               DrawNothing, SendUpdate },
+    { "LcdContrast",                 DrawNothing, SendContrast }
+};
+
+
+
+int main ( void )
+{
+    const LcdLinuxStats *stats = LcdLinuxGetStats();
+    const LcdSimModel   *sim   = LcdSimState();
+    unsigned i;
+    int      fails = 0;
+
+#ifdef CHINA_LCD
+    printf( "==   (CHINA_LCD)\n" );
+#else
+    printf( "==  PCD8544\n" );
+#endif
+
+    LcdInit();
+
+    printf( "%-30s %8s %8s %8s %8s %8s %8s\n", "", "SPI", "GPIO", "", "", "", "" );
+
+    for ( i = 0; i < SCENES; i++ )
+    {
+        LcdClear();
+        LcdUpdate();
+
+        Scenes[i].draw();
+
+        LcdLinuxResetStats();
+        LcdSimResetCounters();
+
+        Scenes[i].send();
+
+        printf( "%-30s %8lu %8lu %8lu %8lu %8lu %8lu\n", Scenes[i].name, stats->spiCalls, stats->gpioCalls,
+                stats->bytes, sim->cmdBytes, sim->dataBytes, stats->errors );
+
+        if ( Scenes[i].draw == DrawFrame ) fails += Compare( Picture );
+
+        fails += ( stats->errors != 0 ) + ( stats->bytes != sim->cmdBytes + sim->dataBytes );
+    }
+
+    printf( "       : %d\n", fails );
+
+    return fails != 0;
+}
+
+
+
+/*
+ *                    :  Compare
+ *               :          
+ * ()           :  image ->    LcdImage
+ *   :  1   ,  0
+ */
+static int Compare ( const byte *image )
+{
+    byte x, y;
+
+    for ( y = 0; y < LCD_Y_RES; y++ )
+    {
+        for ( x = 0; x < LCD_X_RES; x++ )
+        {
+            if ( LcdSimPixel( x, y ) != ( ( pgm_read_byte( &image[ ( y / 8 ) * LCD_X_RES + x ] ) >> ( y % 8 ) ) & 1 ) ) return 1;
+        }
+    }
+
+    return 0;
+}
+
+
+
+// 
+
+static void DrawFrame ( void )
+{
+    LcdImage( Picture );
+}
+
+static void DrawDigit ( void )
+{
+    LcdGotoXYFont( 6, 2 );
+    LcdChr( FONT_1X, '7' );
+}
+
+static void DrawBar ( void )
+{
+    LcdSingleBar( 40, 35, 20, 4, PIXEL_ON );
+}
+
+static void DrawNothing ( void )
+{
+}
+
+static void SendUpdate ( void )
+{
+    LcdUpdate();
+}
+
+static void SendContrast ( void )
+{
+    LcdContrast( 0x40 );
+}
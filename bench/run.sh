@@ -0,0 +1,85 @@
+#!/bin/sh
+#
+# Имя          :  run.sh
+#
+# Описание     :  Сборка и запуск замеров из bench/ на ПК, поверх модели контроллера (LCD_TR_SIM).
+#                 Замер собирается для оригинального дисплея и для китайского клона (заливка - только
+#                 для оригинала, смотри ниже): копия
+#                 исходников с поправленными директивами n3310.h во временном каталоге.
+#                 Результаты записываются в bench/*.txt.
+#                 Запуск из корня репозитория: sh bench/run.sh
+#
+# Автор        :  XANDER
+# Веб-страница :  http://we.easyelectronics.ru/profile/XANDER/
+#
+# Лицензия     :  GPL v3.0
+
+set -e
+export LC_ALL=C
+
+cd "$( dirname "$0" )/.."
+
+CC=${CC:-gcc}
+CFLAGS=${CFLAGS:--O2 -Wall}
+TMP=$( mktemp -d )
+trap 'rm -rf "$TMP"' EXIT
+
+ORIG='s|^#define CHINA_LCD|// #define CHINA_LCD|'
+
+# build <замер> <вариант> [правки n3310.h для sed ...]
+build ()
+{
+    name=$1; variant=$2; shift 2
+    dir=$TMP/$name-$variant
+
+    mkdir -p "$dir"
+    cp n3310*.c n3310*.h picture.h "$dir"
+    for e in "$@"; do sed -i "$e" "$dir/n3310.h"; done
+
+    $CC $CFLAGS -I"$dir" -o "$dir/bench" "bench/$name.c" "$dir"/n3310*.c
+}
+
+# run <замер> [правки n3310.h для sed ...]: оригинал и клон подряд в bench/<замер>.txt
+run ()
+{
+    name=$1; shift
+
+    build "$name" orig "$ORIG" "$@"
+    build "$name" china "$@"
+
+    {
+        "$TMP/$name-orig/bench"
+        echo
+        "$TMP/$name-china/bench"
+    } > "bench/$name.txt"
+
+    echo "bench/$name.txt"
+}
+
+# Заливка от контроллера не зависит: оригинал с LCD_FLOOD_STATS при штатной глубине стека
+# отрезков и с запасом, чтобы видеть, сколько ее нужно на самом деле
+STATS='s|^// #define LCD_FLOOD_STATS|#define LCD_FLOOD_STATS|'
+DEEP='s|^#define LCD_FLOOD_STACK .*|#define LCD_FLOOD_STACK            255|'
+
+flood ()
+{
+    build flood s24 "$ORIG" "$STATS"
+    build flood s255 "$ORIG" "$STATS" "$DEEP"
+
+    {
+        "$TMP/flood-s24/bench"
+        echo
+        "$TMP/flood-s255/bench"
+    } > bench/flood.txt
+
+    echo bench/flood.txt
+}
+
+# Транспорт LCD_TR_LINUX поверх имитации spidev и gpiochip
+LINUX='s|^#ifndef LCD_TRANSPORT|#define LCD_TRANSPORT              LCD_TR_LINUX\n\n#ifndef LCD_TRANSPORT|'
+FAKE='s|^// #define LCD_LINUX_FAKE|#define LCD_LINUX_FAKE|'
+
+run bus
+run fill
+flood
+run linux "$LINUX" "$FAKE"
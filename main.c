@@ -27,7 +27,7 @@ int main()
             LcdSingleBar(0, 47, 4, 5, PIXEL_ON);
             LcdSingleBar(79, 47, 4, 5, PIXEL_ON);
 
-            LcdGotoXYFont(0,2);
+            LcdGotoXYFont(0,1);
             LcdFStr(FONT_2X,(unsigned char*)PSTR("3310LCD"));
 
             LcdGotoXYFont(0,3);
@@ -42,7 +42,7 @@ int main()
 
 
         LcdClear();
-            LcdGotoXYFont(0,2);
+            LcdGotoXYFont(0,1);
             LcdFStr(FONT_2X,(unsigned char*)PSTR(""));
 
             LcdGotoXYFont(0,3);
@@ -26,76 +26,397 @@
  * -     LcdSingleBar (   y)
  */
 
-#include <avr/io.h>
 #include <string.h>
-#include <avr/pgmspace.h>
-#include <avr/interrupt.h>
 #include "n3310.h"
+#include "n3310_tr.h"
+
+#if defined( LCD_CONSOLE ) && defined( LCD_SPRITES )
+    //        ,     ,
+    //          
+    #error "LCD_CONSOLE  LCD_SPRITES   "
+#endif
+
+#ifdef CHINA_LCD
+    //  :        ( LcdFlush)
+    #define LCD_Y_OFFSET           1
+#else
+    #define LCD_Y_OFFSET           0
+#endif
+
+//      LcdLine (   ).    2 * 8191
+//             16- int AVR
+#define LINE_LIMIT                 8191
+
+//    (LcdUpdateAsync)
+#define ASYNC_IDLE                 0   //  
+#define ASYNC_ADDR_X               1   //    X
+#define ASYNC_ADDR_Y               2   //    Y
+#define ASYNC_DATA                 3   //   
+#define ASYNC_TAIL                 4   //     
+
+//      ( LcdFillPolygon).    x + rem / dy
+//   :     xStep + remStep / dy
+typedef struct
+{
+    int  yTop;      //   
+    int  yBot;      //    (   )
+    int  x;         //    ,  
+    int  rem;       //    ,    (0..dy-1)
+    int  xStep;     //  x  ,  
+    int  remStep;   //  x  ,    (0..dy-1)
+    int  dy;        //  
+
+} LcdPolyEdge;
+
+//      ( LcdFloodFill):  y     xl..xr,
+//     y + dy
+typedef struct
+{
+    byte         y;
+    byte         xl;
+    byte         xr;
+    signed char  dy;
+
+} LcdFloodSeg;
+
+#ifdef LCD_SPRITES
+
+//    : LCD_SPRITE_MAX_H       ( h + 14 ) / 8 
+#define LCD_SPRITE_SAVE            ( LCD_SPRITE_MAX_W * ( ( LCD_SPRITE_MAX_H + 14 ) / 8 ) )
+
+//  ( LcdSpriteShow)
+typedef struct
+{
+    const byte *image;     //   Flash ROM, NULL -    
+    const byte *mask;      //    Flash ROM  NULL
+    byte        w;         // 
+    byte        h;         // 
+    int         x;         //     
+    int         y;
+    byte        visible;   //   
+    byte        save [ LCD_SPRITE_SAVE ];   //   
+
+} LcdSprite;
+
+#endif
 
 //    
 
 static void LcdSend    ( byte data, LcdCmdData cd );
-static void Delay      ( void );
+static void LcdDirty   ( int lo, int hi );
+static void LcdClean   ( void );
+static int  LcdGapCost ( int from, int to );
+static void LcdFlush   ( int lo, int hi );
+static byte LcdRawRun  ( int from, int *lo, int *hi );
+static void LcdRunStart( void );
+static byte LcdNextRun ( int *lo, int *hi );
+static void LcdFlushDone( void );
+static void LcdWait    ( void );
+static void LcdAsyncEnd( void );
+static void LcdBox     ( byte x1, byte y1, byte x2, byte y2, LcdPixelMode mode );
+static byte LcdClipBox ( int x1, int y1, int x2, int y2, LcdPixelMode mode );
+static byte LcdRowMask ( byte bank, int y1, int y2 );
+static byte LcdPlot    ( int x, int y, LcdPixelMode mode );
+static void LcdSpan    ( int x1, int x2, int y, LcdPixelMode mode );
+static byte LcdDirtyBox( int x1, int y1, int x2, int y2 );
+static void LcdMask    ( int index, byte mask, LcdPixelMode mode );
+static void LcdDirtyBank( byte bank, byte x1, byte x2 );
+static byte LcdOutCode ( int x, int y );
+static int  LcdLineClamp( long v );
+static void LcdClipSteps( int from, int step, int lo, int hi, int count, int *kLo, int *kHi );
+static int  LcdMinorStep( int m, int major, int minor );
+static void LcdOval    ( int xl, int xr, int yt, int yb, byte rx, byte ry, byte fill, LcdPixelMode mode );
+static void LcdOvalRow ( int xl, int xr, int yt, int yb, int y, int xa, int xb, byte fill, LcdPixelMode mode );
+static void LcdArcDot  ( int x, int y, int dx, int dy, const int *arc, LcdPixelMode mode );
+static int  LcdSin     ( int angle );
+static byte LcdRoundBox( int x1, int y1, int x2, int y2, byte radius, byte fill, LcdPixelMode mode );
+static int  LcdCeil16  ( long value );
+static long LcdSqrt    ( unsigned long value );
+static int  LcdFloorDiv( long a, int b );
+static byte LcdFloodPush( LcdFloodSeg *stack, byte *depth, int y, int xl, int xr, int dy );
+static byte LcdPeek    ( int x, int y );
+static void LcdBlitMem ( const byte *src, byte w, byte h, int x, int y, LcdRop rop, const byte *mask, byte flash );
+static byte LcdSrcByte ( const byte *ptr, byte flash );
+static byte LcdText    ( LcdFontSize size, const byte *str, byte flash, int count );
+static const byte * LcdFontGlyph( const LcdFont *font, byte ch, byte *width );
+static void LcdScaleColumn( const byte *src, byte width, byte banks, LcdFontSize scale, byte *column );
+static int  LcdMeasure ( LcdFontSize size, const byte *str, byte flash );
+
+#ifdef LCD_SPRITES
+static byte LcdSpritePlace( LcdSprite *s, const byte *image, const byte *mask, byte w, byte h, int x, int y );
+static byte LcdSpriteArea ( int x, int y, byte w, byte h, byte *area );
+static void LcdSpriteCopy ( byte *buf, const byte *area, byte toCache );
+#endif
+
+#ifdef LCD_CONSOLE
+static void LcdConsoleCell ( byte row, byte col );
+static void LcdConsoleTouch( void );
+#endif
 
 //  
 
+#ifdef LCD_DOUBLE_BUFFER
+
+//    84*48   504 .     (LcdCache),
+//       (LcdFront). LcdFlip   
+static byte  LcdBuffers [ 2 ][ LCD_CACHE_SIZE ];
+static byte *LcdCache = LcdBuffers[0];
+static byte *LcdFront = LcdBuffers[1];
+
+#else
+
 //    84*48   504 
 static byte  LcdCache [ LCD_CACHE_SIZE ];
 
+//            
+#define LcdFront   LcdCache
+
+#endif
+
 //     ,      ,
-//        . 
-//          .
-static int   LoWaterMark;   //  
-static int   HiWaterMark;   //  
+//      (  8 )  
+//  x   .      
+//   ,          
+//  .  ,     .
+static byte  DirtyLo [ LCD_BANKS ];   //  
+static byte  DirtyHi [ LCD_BANKS ];   //  
+
+//  ,      . LcdFlip 
+//  DirtyLo/DirtyHi,       
+//     
+static byte  FlushLo [ LCD_BANKS ];
+static byte  FlushHi [ LCD_BANKS ];
+
+//    ,       LcdNextRun
+static int   PendLo;   // -1    
+static int   PendHi;
+
+#ifdef LCD_SHADOW
+
+//  ,      . LcdUpdate  
+//    ,     
+static byte  LcdShadow [ LCD_CACHE_SIZE ];
+
+//    (     )
+static byte  ShadowValid;
+
+#endif
+
+//  : ,     
+static volatile byte  AsyncState;
+static int            AsyncIdx;    //     
+static int            AsyncHi;     //    
+static LcdCallback    AsyncDone;
+
+#ifdef CHINA_LCD
+
+static byte           AsyncTail;   //   
+
+//      ( LcdUpdate)
+static const byte ChinaTail [ 3 ] PROGMEM = { 0x21, 0x45, 0x20 };
+
+#endif
+
+//   (,   ):    
+// .  LcdSetClip
+static byte  ClipX0 = 0;
+static byte  ClipY0 = 0;
+static byte  ClipX1 = LCD_X_RES - 1;
+static byte  ClipY1 = LCD_Y_RES - 1;
+
+//  :     .  LcdSetOrigin
+static int   OriginX;
+static int   OriginY;
+
+//     :     .
+//  LcdGotoXYFont  LcdGotoXY
+static int   TextX;
+static int   TextY;
+
+// ,     .  LcdSetTextRop
+static LcdRop TextRop = ROP_COPY;
+
+//    : ASCII[0x20-0x7F]  CP1251[0xC0-0xFF].
+//        ,     0x7F
+static const LcdFontRange FontRanges [] PROGMEM =
+{
+    { 0x20, 0x7F,  0 },
+    { 0xC0, 0xFF, 96 }
+};
+
+//    5x7  FontLookup:    ,    
+static const LcdFont Font5x7 = { 7, 1, 5, 1, 95, 2, FontRanges, NULL, FontLookup[0] };
 
-//     LcdCache[]
-static int   LcdCacheIdx;
+//  .  LcdSetFont
+static const LcdFont *TextFont = &Font5x7;
 
 //   
 static byte  UpdateLcd;
 
+#ifdef LCD_FLOOD_STATS
+//        LcdFloodFill
+static byte  FloodPeak;
+#endif
+
+#ifdef LCD_SPRITES
+//  ( LcdSpriteShow)
+static LcdSprite  Sprites [ LCD_SPRITES ];
+#endif
+
+#ifdef LCD_CONSOLE
+//   ( LcdConsoleFlush):    ,
+//      (  ),    
+static byte          ConsoleChars [ LCD_CONSOLE_ROWS ][ LCD_CONSOLE_COLS ];
+static byte          ConsoleAttrs [ LCD_CONSOLE_ROWS ][ LCD_CONSOLE_COLS ];
+static unsigned int  ConsoleDirty [ LCD_CONSOLE_ROWS ];
+static byte          ConsoleX;
+static byte          ConsoleY;
+static byte          ConsoleAttr;
+#endif
+
+//   0  90     ,   255 ( LcdSin)
+static const byte SinTable [ 91 ] PROGMEM =
+{
+      0,   4,   9,  13,  18,  22,  27,  31,  35,  40,  44,  49,  53,  57,  62,  66,
+     70,  75,  79,  83,  87,  91,  96, 100, 104, 108, 112, 116, 120, 124, 127, 131,
+    135, 139, 143, 146, 150, 153, 157, 160, 164, 167, 171, 174, 177, 180, 183, 186,
+    190, 192, 195, 198, 201, 204, 206, 209, 211, 214, 216, 219, 221, 223, 225, 227,
+    229, 231, 233, 235, 236, 238, 240, 241, 243, 244, 245, 246, 247, 248, 249, 250,
+    251, 252, 253, 253, 254, 254, 254, 255, 255, 255, 255
+};
+
+//    FONT_2X, FONT_3X  FONT_4X:    2, 3  4  ( LcdScaleColumn)
+static const unsigned int ScaleLookup [ 3 ][ 16 ] PROGMEM =
+{
+    { 0x0000, 0x0003, 0x000C, 0x000F, 0x0030, 0x0033, 0x003C, 0x003F,
+      0x00C0, 0x00C3, 0x00CC, 0x00CF, 0x00F0, 0x00F3, 0x00FC, 0x00FF },
+    { 0x0000, 0x0007, 0x0038, 0x003F, 0x01C0, 0x01C7, 0x01F8, 0x01FF,
+      0x0E00, 0x0E07, 0x0E38, 0x0E3F, 0x0FC0, 0x0FC7, 0x0FF8, 0x0FFF },
+    { 0x0000, 0x000F, 0x00F0, 0x00FF, 0x0F00, 0x0F0F, 0x0FF0, 0x0FFF,
+      0xF000, 0xF00F, 0xF0F0, 0xF0FF, 0xFF00, 0xFF0F, 0xFFF0, 0xFFFF }
+};
+
 
 
 /*
  *                    :  LcdInit
- *               :      SPI ,  LCD
+ *               :     (  SPI )   LCD
  * ()           :  
  *   :  
  */
 void LcdInit ( void )
 {
-    // Pull-up     reset 
-    LCD_PORT |= _BV ( LCD_RST_PIN );
-
-    //      
-    LCD_DDR |= _BV( LCD_RST_PIN ) | _BV( LCD_DC_PIN ) | _BV( LCD_CE_PIN ) | _BV( SPI_MOSI_PIN ) | _BV( SPI_CLK_PIN );
+    //    ,   
+    LcdWait();
 
-    //  
-    Delay();
+    //      
+    LcdTrInit();
 
-    //  reset
-    LCD_PORT &= ~( _BV( LCD_RST_PIN ) );
-    Delay();
-    LCD_PORT |= _BV ( LCD_RST_PIN );
-
-    //  SPI:
-    //  ,   ,  , CPOL->0, CPHA->0, Clk/4
-    SPCR = 0x50;
-
-    //  LCD  -    SCE
-    LCD_PORT |= _BV( LCD_CE_PIN );
-
-    //   
+    //     
+    LcdTrBegin();
     LcdSend( 0x21, LCD_CMD ); //     (LCD Extended Commands)
     LcdSend( 0xC8, LCD_CMD ); //   (LCD Vop)
     LcdSend( 0x06, LCD_CMD ); //    (Temp coefficent)
     LcdSend( 0x13, LCD_CMD ); //   (LCD bias mode 1:48)
     LcdSend( 0x20, LCD_CMD ); //        (LCD Standard Commands,Horizontal addressing mode)
     LcdSend( 0x0C, LCD_CMD ); //   (LCD in normal mode)
+    LcdTrEnd();
+
+    //   
+    LcdClean();
+    LcdFlushDone();
+
+#ifdef LCD_SHADOW
+    //        
+    ShadowValid = FALSE;
+#endif
+
+#ifdef LCD_CONSOLE
+    LcdConsoleClear();
+#endif
 
     //   
     LcdClear();
+    LcdFlip();
     LcdUpdate();
+
+#ifdef LCD_CONSOLE
+    //       
+    memset( ConsoleDirty, 0x00, sizeof( ConsoleDirty ) );
+#endif
+}
+
+
+
+/*
+ *                    :  LcdSpan
+ *               :        :     
+ *                           .    ,    ( LcdDirtyBox)
+ * ()           :  x1, x2 ->     (x1 <= x2)
+ *                          y      ->   
+ *                          mode   -> Off, On  Xor.  enum  n3310.h
+ *   :  
+ */
+static void LcdSpan ( int x1, int x2, int y, LcdPixelMode mode )
+{
+    byte *ptr, *end;
+    byte  bit;
+
+    if ( y < ClipY0 || y > ClipY1 ) return;
+
+    if ( x1 < ClipX0 ) x1 = ClipX0;
+    if ( x2 > ClipX1 ) x2 = ClipX1;
+
+    if ( x1 > x2 ) return;
+
+    ptr = &LcdCache[ ( y / 8 ) * LCD_X_RES + x1 ];
+    end = ptr + ( x2 - x1 + 1 );
+    bit = 0x01 << ( y % 8 );
+
+    if ( mode == PIXEL_OFF )
+    {
+        bit = ~bit;
+        while ( ptr != end ) *ptr++ &= bit;
+    }
+    else if ( mode == PIXEL_ON )
+    {
+        while ( ptr != end ) *ptr++ |= bit;
+    }
+    else if ( mode == PIXEL_XOR )
+    {
+        while ( ptr != end ) *ptr++ ^= bit;
+    }
+}
+
+
+
+/*
+ *                    :  LcdDirtyBox
+ *               :       ,     
+ * ()           :  x1, y1 ->     
+ *                          x2, y2 ->     
+ *   :  OK    ,  OUT_OF_BORDER
+ */
+static byte LcdDirtyBox ( int x1, int y1, int x2, int y2 )
+{
+    byte bank;
+    byte response = OK;
+
+    if ( x1 < ClipX0 ) { x1 = ClipX0; response = OUT_OF_BORDER; }
+    if ( x2 > ClipX1 ) { x2 = ClipX1; response = OUT_OF_BORDER; }
+    if ( y1 < ClipY0 ) { y1 = ClipY0; response = OUT_OF_BORDER; }
+    if ( y2 > ClipY1 ) { y2 = ClipY1; response = OUT_OF_BORDER; }
+
+    if ( x1 > x2 || y1 > y2 ) return OUT_OF_BORDER;
+
+    for ( bank = y1 / 8; bank <= y2 / 8; bank++ )
+    {
+        LcdDirtyBank( bank, x1, x2 );
+    }
+
+    //    
+    UpdateLcd = TRUE;
+    return response;
 }
 
 
@@ -119,677 +440,3319 @@ void LcdClear ( void )
     memset( LcdCache, 0x00, LCD_CACHE_SIZE );
     
     //      
-    LoWaterMark = 0;
-    HiWaterMark = LCD_CACHE_SIZE - 1;
+    LcdDirty( 0, LCD_CACHE_SIZE - 1 );
 
     //    
     UpdateLcd = TRUE;
+
+#ifdef LCD_SPRITES
+    {
+        byte id;
+
+        //      ,    
+        for ( id = 0; id < LCD_SPRITES; id++ ) Sprites[id].visible = FALSE;
+    }
+#endif
+
+#ifdef LCD_CONSOLE
+    //     ,  LcdConsoleFlush   
+    LcdConsoleTouch();
+#endif
 }
 
 
 
 /*
  *                    :  LcdUpdate
- *               :      
+ *               :        
  * ()           :  
  *   :  
  */
-void LcdUpdate (void)
+void LcdUpdate ( void )
 {
-    int i;
+    int lo, hi;
 
-    if ( LoWaterMark < 0 )
-        LoWaterMark = 0;
-    else if ( LoWaterMark >= LCD_CACHE_SIZE )
-        LoWaterMark = LCD_CACHE_SIZE - 1;
+    //    ,   
+    LcdWait();
 
-    if ( HiWaterMark < 0 )
-        HiWaterMark = 0;
-    else if ( HiWaterMark >= LCD_CACHE_SIZE )
-        HiWaterMark = LCD_CACHE_SIZE - 1;
+#ifndef LCD_DOUBLE_BUFFER
+    //     ,     
+    LcdFlip();
+#endif
 
-    #ifdef CHINA_LCD  //       
+    LcdRunStart();
 
-        byte x,y;
+    if ( PendLo >= 0 )
+    {
+        //     
+        LcdTrBegin();
 
-        // 102 x 64 -      ,  
-        //          3 .
-        //     -     y+1,  
-        //   (   ,    )
-                
-        x = LoWaterMark % LCD_X_RES;      //    x
-        LcdSend( 0x80 | x, LCD_CMD );     //    LoWaterMark
-        
-        y = LoWaterMark / LCD_X_RES + 1;  //    y+1
-        LcdSend( 0x40 | y, LCD_CMD );     //    LoWaterMark
-
-        for ( i = LoWaterMark; i <= HiWaterMark; i++ )
-        {
-            //     
-            LcdSend( LcdCache[i], LCD_DATA );
-            
-            x++;                 //    x,      
-            if (x >= LCD_X_RES)  //    ,      (x=0; y++)
-            {
-                //  ,       ,
-                //     ,    :)
-                x=0;                
-                LcdSend( 0x80, LCD_CMD );
-                y++;
-                LcdSend( 0x40 | y, LCD_CMD );
-            }
+        while ( LcdNextRun( &lo, &hi ) )
+        {
+            LcdFlush( lo, hi );
         }
 
+    #ifdef CHINA_LCD
         LcdSend( 0x21, LCD_CMD );    //    
         LcdSend( 0x45, LCD_CMD );    //    5   (  ,   )
         LcdSend( 0x20, LCD_CMD );    //       
-
-    #else  //    
-
-        //       LoWaterMark
-        LcdSend( 0x80 | ( LoWaterMark % LCD_X_RES ), LCD_CMD );
-        LcdSend( 0x40 | ( LoWaterMark / LCD_X_RES ), LCD_CMD );
-
-        //     
-        for ( i = LoWaterMark; i <= HiWaterMark; i++ )
-        {
-            //          ,
-            //     
-            LcdSend( LcdCache[i], LCD_DATA );
-        }
-
     #endif
 
-    //     
-    LoWaterMark = LCD_CACHE_SIZE - 1;
-    HiWaterMark = 0;
+        LcdTrEnd();
+    }
 
-    //    
-    UpdateLcd = FALSE;
+    LcdFlushDone();
 }
 
 
 
 /*
- *                    :  LcdSend
- *               :      
- * ()           :  data ->   
- *                          cd   ->    ( enum  n3310.h)
+ *                    :  LcdUpdateAsync
+ *               :           
+ *                              .    
+ *                           LcdTrDone    .    
+ *                          ,      
+ * ()           :  done -> ,    ( )   ,  NULL
  *   :  
  */
-static void LcdSend ( byte data, LcdCmdData cd )
+void LcdUpdateAsync ( LcdCallback done )
 {
-    //    (  )
-    LCD_PORT &= ~( _BV( LCD_CE_PIN ) );
+    //    
+    LcdWait();
 
-    if ( cd == LCD_DATA )
-    {
-        LCD_PORT |= _BV( LCD_DC_PIN );
-    }
-    else
+#ifndef LCD_DOUBLE_BUFFER
+    //     ,     
+    LcdFlip();
+#endif
+
+    LcdRunStart();
+
+    AsyncDone = done;
+
+    if ( !LcdNextRun( &AsyncIdx, &AsyncHi ) )
     {
-        LCD_PORT &= ~( _BV( LCD_DC_PIN ) );
+        //  
+        LcdAsyncEnd();
+        return;
     }
 
-    //     
-    SPDR = data;
+    //    LcdAsyncEnd.    ,    LcdTrDone
+    LcdTrBegin();
+    AsyncState = ASYNC_ADDR_X;
+    LcdTrStart( 0x80 | ( AsyncIdx % LCD_X_RES ), LCD_CMD );
+}
+
 
-    //   
-    while ( (SPSR & 0x80) != 0x80 );
 
-    //   
-    LCD_PORT |= _BV( LCD_CE_PIN );
+/*
+ *                    :  LcdBusy
+ *               :  ,    
+ * ()           :  
+ *   :  TRUE    ,  FALSE
+ */
+byte LcdBusy ( void )
+{
+    return AsyncState != ASYNC_IDLE;
 }
 
 
 
 /*
- *                    :  LcdContrast
- *               :    
- * ()           :   ->   0x00  0x7F
+ *                    :  LcdTrDone
+ *               :     .  
+ *                               ,  LcdTrStart
+ * ()           :  
  *   :  
  */
-void LcdContrast ( byte contrast )
+void LcdTrDone ( void )
 {
-    LcdSend( 0x21, LCD_CMD );              //   
-    LcdSend( 0x80 | contrast, LCD_CMD );   //   
-    LcdSend( 0x20, LCD_CMD );              //   ,  
+    byte data;
+
+    switch ( AsyncState )
+    {
+        case ASYNC_ADDR_X:
+            AsyncState = ASYNC_ADDR_Y;
+            LcdTrStart( 0x40 | ( AsyncIdx / LCD_X_RES + LCD_Y_OFFSET ), LCD_CMD );
+            return;
+
+        case ASYNC_ADDR_Y:
+        case ASYNC_DATA:
+            if ( AsyncIdx <= AsyncHi )
+            {
+            #ifdef CHINA_LCD
+                if ( AsyncState == ASYNC_DATA && AsyncIdx % LCD_X_RES == 0 )
+                {
+                    //     ,    
+                    AsyncState = ASYNC_ADDR_X;
+                    LcdTrStart( 0x80, LCD_CMD );
+                    return;
+                }
+            #endif
+
+                AsyncState = ASYNC_DATA;
+                data = LcdFront[ AsyncIdx ];
+
+            #ifdef LCD_SHADOW
+                // ,     
+                LcdShadow[ AsyncIdx ] = data;
+            #endif
+
+                AsyncIdx++;
+                LcdTrStart( data, LCD_DATA );
+                return;
+            }
+
+            //  ,   
+            if ( LcdNextRun( &AsyncIdx, &AsyncHi ) )
+            {
+                AsyncState = ASYNC_ADDR_X;
+                LcdTrStart( 0x80 | ( AsyncIdx % LCD_X_RES ), LCD_CMD );
+                return;
+            }
+
+        #ifdef CHINA_LCD
+            //   ,   
+            AsyncState = ASYNC_TAIL;
+            AsyncTail  = 1;
+            LcdTrStart( pgm_read_byte( &ChinaTail[0] ), LCD_CMD );
+            return;
+
+        case ASYNC_TAIL:
+            if ( AsyncTail < sizeof( ChinaTail ) )
+            {
+                LcdTrStart( pgm_read_byte( &ChinaTail[ AsyncTail++ ] ), LCD_CMD );
+                return;
+            }
+        #endif
+
+            LcdTrEnd();
+            LcdAsyncEnd();
+            return;
+
+        default:
+            return;
+    }
 }
 
 
 
 /*
- *                    :  Delay
- *               :       LCD
+ *                    :  LcdAsyncEnd
+ *               :        
  * ()           :  
  *   :  
  */
-static void Delay ( void )
+static void LcdAsyncEnd ( void )
 {
-    int i;
+    LcdFlushDone();
 
-    for ( i = -32000; i < 32000; i++ );
+    AsyncState = ASYNC_IDLE;
+
+    if ( AsyncDone )
+        AsyncDone();
 }
 
 
 
 /*
- *                    :  LcdGotoXYFont
- *               :      x,y    
- * ()           :  x,y ->    . : 0,0 .. 13,5
- *   :      n3310.h
+ *                    :  LcdWait
+ *               :     
+ * ()           :  
+ *   :  
  */
-byte LcdGotoXYFont ( byte x, byte y )
+static void LcdWait ( void )
 {
-    //  
-    if( x > 13 || y > 5 ) return OUT_OF_BORDER;
-
-    //   .      504 
-    LcdCacheIdx = x * 6 + y * 84;
-    return OK;
+    while ( AsyncState != ASYNC_IDLE )
+    {
+        //     ,     
+        LcdTrPoll();
+    }
 }
 
 
 
 /*
- *                    :  LcdChr
- *               :       ,    
- * ()           :  size ->  .  enum  n3310.h
- *                          ch   ->   
- *   :      n3310lcd.h
+ *                    :  LcdFlip
+ *               :     (LCD_DOUBLE_BUFFER)   :  
+ *                                LcdUpdate/LcdUpdateAsync,  
+ *                           ,    .     
+ *                                (LcdUpdate   )
+ * ()           :  
+ *   :  
  */
-byte LcdChr ( LcdFontSize size, byte ch )
+void LcdFlip ( void )
 {
-    byte i, c;
-    byte b1, b2;
-    int  tmpIdx;
+    byte bank;
 
-    if ( LcdCacheIdx < LoWaterMark )
-    {
-        //   
-        LoWaterMark = LcdCacheIdx;
-    }
+#ifdef LCD_DOUBLE_BUFFER
+    byte *tmp;
+    int   lo;
+#endif
 
-    if ( (ch >= 0x20) && (ch <= 0x7F) )
-    {
-        //      ASCII[0x20-0x7F]
-        ch -= 32;
-    }
-    else if ( ch >= 0xC0 )
-    {
-        //      CP1251[0xC0-0xFF]
-        ch -= 96;
-    }
-    else
+    //    ,   
+    LcdWait();
+
+#ifdef LCD_DOUBLE_BUFFER
+    tmp      = LcdFront;
+    LcdFront = LcdCache;
+    LcdCache = tmp;
+
+    //           
+    //    ,   
+    for ( bank = 0; bank < LCD_BANKS; bank++ )
     {
-        //   (       )
-        ch = 95;
+        if ( DirtyLo[bank] > DirtyHi[bank] ) continue;
+
+        lo = bank * LCD_X_RES + DirtyLo[bank];
+        memcpy( &LcdCache[lo], &LcdFront[lo], DirtyHi[bank] - DirtyLo[bank] + 1 );
     }
+#endif
 
-    if ( size == FONT_1X )
+    //    ,    
+    for ( bank = 0; bank < LCD_BANKS; bank++ )
     {
-        for ( i = 0; i < 5; i++ )
-        {
-            //       
-            LcdCache[LcdCacheIdx++] = pgm_read_byte( &(FontLookup[ch][i]) ) << 1;
-        }
+        if ( DirtyLo[bank] < FlushLo[bank] ) FlushLo[bank] = DirtyLo[bank];
+        if ( DirtyHi[bank] > FlushHi[bank] ) FlushHi[bank] = DirtyHi[bank];
     }
-    else if ( size == FONT_2X )
+
+    //     
+    LcdClean();
+
+    //    
+    UpdateLcd = FALSE;
+}
+
+
+
+/*
+ *                    :  LcdFlushDone
+ *               :  ,         
+ * ()           :  
+ *   :  
+ */
+static void LcdFlushDone ( void )
+{
+    memset( FlushLo, LCD_X_RES, LCD_BANKS );
+    memset( FlushHi, 0x00, LCD_BANKS );
+
+#ifdef LCD_SHADOW
+    //      
+    ShadowValid = TRUE;
+#endif
+}
+
+
+
+/*
+ *                    :  LcdRawRun
+ *               :      ,    from.
+ *                            LCD_SHADOW     ,     
+ * ()           :  from ->   ,    
+ *                          lo   ->      
+ *                          hi   ->      
+ *   :  TRUE   ,  FALSE
+ */
+static byte LcdRawRun ( int from, int *lo, int *hi )
+{
+    byte bank, x;
+    int  end;
+
+    while ( from < LCD_CACHE_SIZE )
     {
-        tmpIdx = LcdCacheIdx - 84;
+        bank = from / LCD_X_RES;
+        x = from - bank * LCD_X_RES;
 
-        if ( tmpIdx < LoWaterMark )
+        //        -   
+        if ( FlushLo[bank] > FlushHi[bank] || x > FlushHi[bank] )
         {
-            LoWaterMark = tmpIdx;
+            from = ( bank + 1 ) * LCD_X_RES;
+            continue;
         }
 
-        if ( tmpIdx < 0 ) return OUT_OF_BORDER;
+        if ( x < FlushLo[bank] )
+            from = bank * LCD_X_RES + FlushLo[bank];
+
+        end = bank * LCD_X_RES + FlushHi[bank];
 
-        for ( i = 0; i < 5; i++ )
+    #ifdef LCD_SHADOW
+        if ( ShadowValid )
         {
-            //        
-            c = pgm_read_byte(&(FontLookup[ch][i])) << 1;
-            //  
-            //  
-            b1 =  (c & 0x01) * 3;
-            b1 |= (c & 0x02) * 6;
-            b1 |= (c & 0x04) * 12;
-            b1 |= (c & 0x08) * 24;
+            //  ,       
+            while ( from <= end && LcdFront[from] == LcdShadow[from] )
+                from++;
+
+            if ( from > end )
+            {
+                from = ( bank + 1 ) * LCD_X_RES;
+                continue;
+            }
 
-            c >>= 4;
-            //  
-            b2 =  (c & 0x01) * 3;
-            b2 |= (c & 0x02) * 6;
-            b2 |= (c & 0x04) * 12;
-            b2 |= (c & 0x08) * 24;
+            //      
+            *lo = from;
+            while ( from < end && LcdFront[from + 1] != LcdShadow[from + 1] )
+                from++;
 
-            //     
-            LcdCache[tmpIdx++] = b1;
-            LcdCache[tmpIdx++] = b1;
-            LcdCache[tmpIdx + 82] = b2;
-            LcdCache[tmpIdx + 83] = b2;
+            *hi = from;
+            return TRUE;
         }
+    #endif
 
-        //  x  
-        LcdCacheIdx = (LcdCacheIdx + 11) % LCD_CACHE_SIZE;
-    }
-
-    if ( LcdCacheIdx > HiWaterMark )
-    {
-        //   
-        HiWaterMark = LcdCacheIdx;
+        *lo = from;
+        *hi = end;
+        return TRUE;
     }
 
-    //    
-    LcdCache[LcdCacheIdx] = 0x00;
-    //     LCD_CACHE_SIZE - 1,   
-    if(LcdCacheIdx == (LCD_CACHE_SIZE - 1) )
-    {
-        LcdCacheIdx = 0;
-        return OK_WITH_WRAP;
-    }
-    //    
-    LcdCacheIdx++;
-    return OK;
+    return FALSE;
 }
 
 
 
 /*
- *                    :  LcdStr
- *               :           RAM
- * ()           :  size      ->  .  enum  n3310.h
- *                          dataArray ->      
- *   :      n3310lcd.h
+ *                    :  LcdRunStart
+ *               :          ( LcdNextRun)
+ * ()           :  
+ *   :  
  */
-byte LcdStr ( LcdFontSize size, byte dataArray[] )
+static void LcdRunStart ( void )
 {
-    byte tmpIdx=0;
-    byte response;
-    while( dataArray[ tmpIdx ] != '\0' )
-    {
-        //  
-        response = LcdChr( size, dataArray[ tmpIdx ] );
-        //      OUT_OF_BORDER,
-        //       
-        if( response == OUT_OF_BORDER)
-            return OUT_OF_BORDER;
-        //  
-        tmpIdx++;
-    }
-    return OK;
+    if ( !LcdRawRun( 0, &PendLo, &PendHi ) )
+        PendLo = -1;
 }
 
 
 
 /*
- *                    :  LcdFStr
- *               :           Flash ROM
- * ()           :  size    ->  .  enum  n3310.h
- *                          dataPtr ->      
- *   :      n3310lcd.h
- *                 :  LcdFStr(FONT_1X, PSTR("Hello World"));
- *                          LcdFStr(FONT_1X, &name_of_string_as_array);
+ *                    :  LcdNextRun
+ *               :      .   ,
+ *                                ,    
+ * ()           :  lo ->      
+ *                          hi ->      
+ *   :  TRUE   , FALSE    
  */
-byte LcdFStr ( LcdFontSize size, const byte *dataPtr )
+static byte LcdNextRun ( int *lo, int *hi )
 {
-    byte c;
-    byte response;
-    for ( c = pgm_read_byte( dataPtr ); c; ++dataPtr, c = pgm_read_byte( dataPtr ) )
+    int l, h;
+
+    if ( PendLo < 0 ) return FALSE;
+
+    *lo = PendLo;
+    *hi = PendHi;
+    PendLo = -1;
+
+    while ( LcdRawRun( *hi + 1, &l, &h ) )
     {
-        //  
-        response = LcdChr( size, c );
-        if(response == OUT_OF_BORDER)
-            return OUT_OF_BORDER;
+        if ( LcdGapCost( *hi, l ) > LCD_ADDR_COST )
+        {
+            //    ,     
+            PendLo = l;
+            PendHi = h;
+            break;
+        }
+
+        *hi = h;
     }
 
-    return OK;
+    return TRUE;
 }
 
 
 
 /*
- *                    :  LcdPixel
- *               :       (x,y)
- * ()           :  x,y  ->   
- *                          mode -> Off, On  Xor.  enum  n3310.h
- *   :      n3310lcd.h
+ *                    :  LcdFlush
+ *               :       ,    
+ * ()           :  lo ->     
+ *                          hi ->     
+ *   :  
  */
-byte LcdPixel ( byte x, byte y, LcdPixelMode mode )
+static void LcdFlush ( int lo, int hi )
 {
-    int  index;
-    byte  offset;
-    byte  data;
-
-    //     
-    if ( x >= LCD_X_RES || y >= LCD_Y_RES) return OUT_OF_BORDER;
+#ifdef LCD_SHADOW
+    // ,     
+    memcpy( &LcdShadow[lo], &LcdFront[lo], hi - lo + 1 );
+#endif
 
-    //    
-    index = ( ( y / 8 ) * 84 ) + x;
-    offset  = y - ( ( y / 8 ) * 8 );
+    #ifdef CHINA_LCD  //       
 
-    data = LcdCache[ index ];
+        byte x,y;
+        int  count;
 
-    //  
+        // 102 x 64 -      ,  
+        //          3 .
+        //     -     y+1,  
+        //   (   ,    )
+
+        x = lo % LCD_X_RES;      //   x
+        y = lo / LCD_X_RES + 1;  //   y+1
+
+        while ( lo <= hi )
+        {
+            //  102 ,   84,       
+            //  .       ,
+            //         ,    :)
+            LcdSend( 0x80 | x, LCD_CMD );
+            LcdSend( 0x40 | y, LCD_CMD );
+
+            //           
+            count = LCD_X_RES - x;
+            if ( count > hi - lo + 1 )
+                count = hi - lo + 1;
+
+            LcdTrWrite( &LcdFront[lo], count, LCD_DATA );
+
+            lo += count;
+            x = 0;
+            y++;
+        }
+
+    #else  //    
+
+        //        
+        LcdSend( 0x80 | ( lo % LCD_X_RES ), LCD_CMD );
+        LcdSend( 0x40 | ( lo / LCD_X_RES ), LCD_CMD );
+
+        //     .     
+        //     ,     
+        LcdTrWrite( &LcdFront[lo], hi - lo + 1, LCD_DATA );
+
+    #endif
+}
+
+
+
+/*
+ *                    :  LcdGapCost
+ *               :  ,           
+ * ()           :  from ->     
+ *                          to   ->     
+ *   :   
+ */
+static int LcdGapCost ( int from, int to )
+{
+    #ifdef CHINA_LCD
+        //       , 
+        //          
+        return to - from - 1 + ( to / LCD_X_RES - from / LCD_X_RES ) * LCD_ADDR_COST;
+    #else
+        return to - from - 1;
+    #endif
+}
+
+
+
+/*
+ *                    :  LcdDirty
+ *               :      
+ * ()           :  lo ->      
+ *                          hi ->      
+ *   :  
+ */
+static void LcdDirty ( int lo, int hi )
+{
+    byte bank, x;
+
+    if ( lo < 0 ) lo = 0;
+    if ( hi >= LCD_CACHE_SIZE ) hi = LCD_CACHE_SIZE - 1;
+
+    //     ,    
+    while ( lo <= hi )
+    {
+        bank = lo / LCD_X_RES;
+        x = lo - bank * LCD_X_RES;
+
+        if ( x < DirtyLo[bank] )
+            DirtyLo[bank] = x;
+
+        lo = ( bank + 1 ) * LCD_X_RES;
+        x = ( hi < lo ) ? hi - bank * LCD_X_RES : LCD_X_RES - 1;
+
+        if ( x > DirtyHi[bank] )
+            DirtyHi[bank] = x;
+    }
+}
+
+
+
+/*
+ *                    :  LcdClean
+ *               :         
+ * ()           :  
+ *   :  
+ */
+static void LcdClean ( void )
+{
+    memset( DirtyLo, LCD_X_RES, LCD_BANKS );
+    memset( DirtyHi, 0x00, LCD_BANKS );
+}
+
+
+
+/*
+ *                    :  LcdSend
+ *               :       .    
+ *                          ( LcdTrBegin  LcdTrEnd),  CE  ,  DC  
+ *                                
+ * ()           :  data ->   
+ *                          cd   ->    ( enum  n3310.h)
+ *   :  
+ */
+static void LcdSend ( byte data, LcdCmdData cd )
+{
+    //      ( LCD_TRANSPORT  n3310.h)
+    LcdTrWrite( &data, 1, cd );
+}
+
+
+
+/*
+ *                    :  LcdContrast
+ *               :    
+ * ()           :   ->   0x00  0x7F
+ *   :  
+ */
+void LcdContrast ( byte contrast )
+{
+    //    ,   
+    LcdWait();
+
+    LcdTrBegin();
+    LcdSend( 0x21, LCD_CMD );              //   
+    LcdSend( 0x80 | contrast, LCD_CMD );   //   
+    LcdSend( 0x20, LCD_CMD );              //   ,  
+    LcdTrEnd();
+}
+
+
+
+/*
+ *                    :  LcdSetClip
+ *               :    :      ,
+ *                               ,   
+ * ()           :  x1, y1 ->      
+ *                          x2, y2 ->       ()
+ *   :      n3310lcd.h.    
+ *                               OUT_OF_BORDER
+ *                 :  LcdSetClip( 0, 0, LCD_X_RES - 1, LCD_Y_RES - 1 );   //  
+ */
+byte LcdSetClip ( int x1, int y1, int x2, int y2 )
+{
+    int  tmp;
+    byte response = OK;
+
+    //       
+    if ( x1 > x2 )
+    {
+        tmp = x1; x1 = x2; x2 = tmp;
+    }
+
+    if ( y1 > y2 )
+    {
+        tmp = y1; y1 = y2; y2 = tmp;
+    }
+
+    if ( x1 < 0 ) { x1 = 0; response = OUT_OF_BORDER; }
+    if ( y1 < 0 ) { y1 = 0; response = OUT_OF_BORDER; }
+    if ( x2 > LCD_X_RES - 1 ) { x2 = LCD_X_RES - 1; response = OUT_OF_BORDER; }
+    if ( y2 > LCD_Y_RES - 1 ) { y2 = LCD_Y_RES - 1; response = OUT_OF_BORDER; }
+
+    //     :   
+    if ( x1 > x2 || y1 > y2 )
+    {
+        x1 = LCD_X_RES - 1; x2 = 0;
+        y1 = LCD_Y_RES - 1; y2 = 0;
+    }
+
+    ClipX0 = x1;
+    ClipY0 = y1;
+    ClipX1 = x2;
+    ClipY1 = y2;
+
+    return response;
+}
+
+
+
+/*
+ *                    :  LcdSetOrigin
+ *               :    : (x,y)     ,
+ *                                
+ * ()           :  x, y ->  ,     (0,0)
+ *   :  
+ */
+void LcdSetOrigin ( int x, int y )
+{
+    OriginX = x;
+    OriginY = y;
+}
+
+
+
+/*
+ *                    :  LcdGotoXYFont
+ *               :      x,y    .
+ *                              6x8 ,       
+ * ()           :  x,y ->    . : 0,0 .. 13,5
+ *   :      n3310.h
+ */
+byte LcdGotoXYFont ( byte x, byte y )
+{
+    //  
+    if( x > 13 || y > 5 ) return OUT_OF_BORDER;
+
+    //       
+    TextX = x * 6;
+    TextY = y * 8;
+    return OK;
+}
+
+
+
+/*
+ *                    :  LcdGotoXY
+ *               :      x,y    .  
+ *                            ,      ,     
+ * ()           :  x,y ->       
+ *   :      n3310.h. OUT_OF_BORDER,    
+ *                           (   ,   )
+ */
+byte LcdGotoXY ( int x, int y )
+{
+    TextX = x + OriginX;
+    TextY = y + OriginY;
+
+    if ( TextX < ClipX0 || TextX > ClipX1 || TextY < ClipY0 || TextY > ClipY1 ) return OUT_OF_BORDER;
+
+    return OK;
+}
+
+
+
+/*
+ *                    :  LcdSetTextRop
+ *               :   ,     . ROP_COPY ( )
+ *                             , ROP_OR  ROP_XOR    
+ * ()           :  rop ->    .  enum  n3310.h
+ *   :  
+ */
+void LcdSetTextRop ( LcdRop rop )
+{
+    TextRop = rop;
+}
+
+
+
+/*
+ *                    :  LcdSetFont
+ *               :     LcdChr, LcdStr  LcdFStr ( LcdFont  n3310.h).
+ *                            ,        
+ * ()           :  font ->   NULL    5x7
+ *   :      n3310.h. OUT_OF_MEMORY,   
+ *                          LCD_FONT_MAX_H (  )
+ */
+byte LcdSetFont ( const LcdFont *font )
+{
+    if ( font && font->height > LCD_FONT_MAX_H ) return OUT_OF_MEMORY;
+
+    TextFont = font ? font : &Font5x7;
+    return OK;
+}
+
+
+
+/*
+ *                    :  LcdMeasureString
+ *               :      RAM   ,     
+ *                             (      ).
+ *                          ,     : LcdGotoXY( 84 - , y )
+ * ()           :  size      ->  .  enum  n3310.h
+ *                          dataArray -> 
+ *   :    
+ */
+int LcdMeasureString ( LcdFontSize size, const byte dataArray[] )
+{
+    return LcdMeasure( size, dataArray, FALSE );
+}
+
+
+
+/*
+ *                    :  LcdFMeasureString
+ *               :      Flash ROM    ( LcdMeasureString)
+ * ()           :  size    ->  .  enum  n3310.h
+ *                          dataPtr ->   
+ *   :    
+ */
+int LcdFMeasureString ( LcdFontSize size, const byte *dataPtr )
+{
+    return LcdMeasure( size, dataPtr, TRUE );
+}
+
+
+
+/*
+ *                    :  LcdChr
+ *               :       ,    ( LcdText)
+ * ()           :  size ->  .  enum  n3310.h
+ *                          ch   ->   
+ *   :      n3310lcd.h
+ */
+byte LcdChr ( LcdFontSize size, byte ch )
+{
+    return LcdText( size, &ch, FALSE, 1 );
+}
+
+
+
+/*
+ *                    :  LcdStr
+ *               :           RAM
+ * ()           :  size      ->  .  enum  n3310.h
+ *                          dataArray ->      
+ *   :      n3310lcd.h
+ */
+byte LcdStr ( LcdFontSize size, byte dataArray[] )
+{
+    return LcdText( size, dataArray, FALSE, -1 );
+}
+
+
+
+/*
+ *                    :  LcdFStr
+ *               :           Flash ROM
+ * ()           :  size    ->  .  enum  n3310.h
+ *                          dataPtr ->      
+ *   :      n3310lcd.h
+ *                 :  LcdFStr(FONT_1X, PSTR("Hello World"));
+ *                          LcdFStr(FONT_1X, &name_of_string_as_array);
+ */
+byte LcdFStr ( LcdFontSize size, const byte *dataPtr )
+{
+    return LcdText( size, dataPtr, TRUE, -1 );
+}
+
+
+
+/*
+ *                    :  LcdText
+ *               :      ( LcdSetFont)    .
+ *                             LcdBlitMem   LcdSetTextRop,   
+ *                           ,       .  FONT_1X  
+ *                            Flash ROM,        ( LcdScaleColumn).
+ *                                   ROP_COPY  ROP_AND .
+ *                                ,     
+ *                           ,     -   .
+ *                                  
+ * ()           :  size  ->  .  enum  n3310.h
+ *                          str   -> 
+ *                          flash -> TRUE -   Flash ROM, FALSE -  
+ *                          count ->    -1,    '\0'
+ *   :  OUT_OF_BORDER,  -    , OK_WITH_WRAP,  
+ *                             ,  OK
+ */
+static byte LcdText ( LcdFontSize size, const byte *str, byte flash, int count )
+{
+    const byte *glyph;
+    byte        column [ LCD_FONT_MAX_H / 2 ];
+    byte        ch, w, h, top, banks, col, i;
+    byte        response = OK;
+    byte        wrap = FALSE;
+    int         adv, lineH;
+    int         lineX = TextX;
+
+    //    
+    h     = TextFont->height * size;
+    top   = TextFont->top * size;
+    lineH = top + h;
+    banks = ( TextFont->height + 7 ) / 8;
+
+    for ( ; count != 0; count-- )
+    {
+        ch = LcdSrcByte( str++, flash );
+
+        if ( count < 0 && ch == '\0' ) break;
+
+        glyph = LcdFontGlyph( TextFont, ch, &w );
+        adv   = ( w + TextFont->spacing ) * size;
+
+        if ( size == FONT_1X )
+        {
+            LcdBlitMem( glyph, w, h, TextX, TextY + top, TextRop, NULL, TRUE );
+        }
+        else
+        {
+            for ( col = 0; col < w; col++ )
+            {
+                LcdScaleColumn( glyph + col, w, banks, size, column );
+
+                //    size 
+                for ( i = 0; i < size; i++ )
+                {
+                    LcdBlitMem( column, 1, h, TextX + col * size + i, TextY + top, TextRop, NULL, FALSE );
+                }
+            }
+        }
+
+        //   ROP_COPY  ROP_AND ,     
+        if ( TextRop == ROP_COPY || TextRop == ROP_AND )
+        {
+            if ( top ) LcdClipBox( TextX, TextY, TextX + adv - 1, TextY + top - 1, PIXEL_OFF );
+            if ( TextFont->spacing ) LcdClipBox( TextX + w * size, TextY + top, TextX + adv - 1, TextY + lineH - 1, PIXEL_OFF );
+        }
+
+        TextX += adv;
+
+        if ( TextX >= LCD_X_RES )
+        {
+            //   :       
+            if ( LcdDirtyBox( lineX, TextY, TextX - 1, TextY + lineH - 1 ) != OK ) response = OUT_OF_BORDER;
+
+            TextX -= LCD_X_RES;
+            TextY += lineH;
+            lineX  = TextX;
+
+            if ( TextY >= LCD_Y_RES )
+            {
+                TextY = 0;
+                wrap  = TRUE;
+            }
+        }
+    }
+
+    //   
+    if ( TextX > lineX && LcdDirtyBox( lineX, TextY, TextX - 1, TextY + lineH - 1 ) != OK ) response = OUT_OF_BORDER;
+
+    if ( response == OK && wrap ) response = OK_WITH_WRAP;
+
+    return response;
+}
+
+
+
+/*
+ *                    :  LcdFontGlyph
+ *               :       ( LcdFont  n3310.h)
+ * ()           :  font  -> 
+ *                          ch    ->  
+ *                          width ->      
+ *   :     Flash ROM   LcdFBlit
+ */
+static const byte * LcdFontGlyph ( const LcdFont *font, byte ch, byte *width )
+{
+    const LcdFontRange *range = font->ranges;
+    byte                i, glyph = font->missing;
+    unsigned int        first;
+
+    for ( i = 0; i < font->rangeCount; i++, range++ )
+    {
+        if ( ch >= pgm_read_byte( &range->first ) && ch <= pgm_read_byte( &range->last ) )
+        {
+            glyph = pgm_read_byte( &range->glyph ) + ch - pgm_read_byte( &range->first );
+            break;
+        }
+    }
+
+    if ( font->offsets )
+    {
+        //  :  -   
+        first  = pgm_read_word( &font->offsets[ glyph ] );
+        *width = pgm_read_word( &font->offsets[ glyph + 1 ] ) - first;
+    }
+    else
+    {
+        first  = glyph * font->width;
+        *width = font->width;
+    }
+
+    return font->data + first * ( ( font->height + 7 ) / 8 );
+}
+
+
+
+/*
+ *                    :  LcdScaleColumn
+ *               :      scale   .    
+ *                            ScaleLookup  4 * scale ,      .
+ *                               ( LcdText)
+ * ()           :  src    ->    Flash ROM (  LcdFBlit)
+ *                          width  ->  ,    
+ *                          banks  ->   
+ *                          scale  ->    ,  FONT_2X  FONT_4X
+ *                          column ->     1   LcdBlit, banks * scale 
+ *   :  
+ */
+static void LcdScaleColumn ( const byte *src, byte width, byte banks, LcdFontSize scale, byte *column )
+{
+    const unsigned int *lookup = ScaleLookup[ scale - FONT_2X ];
+    unsigned long       bits = 0;   //    ,  -  
+    byte                count = 0;  //  
+    byte                bank, c;
+
+    for ( bank = 0; bank < banks; bank++, src += width )
+    {
+        c = pgm_read_byte( src );
+
+        bits  |= (unsigned long)pgm_read_word( &lookup[ c & 0x0F ] ) << count;
+        count += scale * 4;
+
+        bits  |= (unsigned long)pgm_read_word( &lookup[ c >> 4 ] ) << count;
+        count += scale * 4;
+
+        while ( count >= 8 )
+        {
+            *column++ = (byte)bits;
+            bits    >>= 8;
+            count    -= 8;
+        }
+    }
+}
+
+
+
+/*
+ *                    :  LcdMeasure
+ *               :          
+ * ()           :  size  ->  .  enum  n3310.h
+ *                          str   -> 
+ *                          flash -> TRUE -   Flash ROM, FALSE -  
+ *   :    
+ */
+static int LcdMeasure ( LcdFontSize size, const byte *str, byte flash )
+{
+    byte ch, w;
+    int  width = 0;
+
+    for ( ch = LcdSrcByte( str, flash ); ch; ch = LcdSrcByte( ++str, flash ) )
+    {
+        LcdFontGlyph( TextFont, ch, &w );
+        width += w + TextFont->spacing;
+    }
+
+    return width * size;
+}
+
+
+
+/*
+ *                    :  LcdPixel
+ *               :       (x,y)
+ * ()           :  x,y  ->   
+ *                          mode -> Off, On  Xor.  enum  n3310.h
+ *   :      n3310lcd.h
+ */
+byte LcdPixel ( int x, int y, LcdPixelMode mode )
+{
+    return LcdPlot( x + OriginX, y + OriginY, mode );
+}
+
+
+
+/*
+ *                    :  LcdPlot
+ *               :      ,    
+ * ()           :  x,y  ->    
+ *                          mode -> Off, On  Xor.  enum  n3310.h
+ *   :      n3310lcd.h
+ */
+static byte LcdPlot ( int x, int y, LcdPixelMode mode )
+{
+    int  index;
+    byte  offset;
+    byte  data;
+    byte  bank;
+
+    //     
+    if ( x < ClipX0 || x > ClipX1 || y < ClipY0 || y > ClipY1 ) return OUT_OF_BORDER;
+
+    //    
+    bank   = y / 8;
+    index  = ( bank * 84 ) + x;
+    offset = y - ( bank * 8 );
+
+    data = LcdCache[ index ];
+
+    //  
+
+    //  PIXEL_OFF
+    if ( mode == PIXEL_OFF )
+    {
+        data &= ( ~( 0x01 << offset ) );
+    }
+    //  PIXEL_ON
+    else if ( mode == PIXEL_ON )
+    {
+        data |= ( 0x01 << offset );
+    }
+    //  PIXEL_XOR
+    else if ( mode  == PIXEL_XOR )
+    {
+        data ^= ( 0x01 << offset );
+    }
+
+    //     
+    LcdCache[ index ] = data;
+
+    if ( x < DirtyLo[bank] )
+    {
+        //   
+        DirtyLo[bank] = x;
+    }
+
+    if ( x > DirtyHi[bank] )
+    {
+        //   
+        DirtyHi[bank] = x;
+    }
+    return OK;
+}
+
+
+
+/*
+ *                    :  LcdLine
+ *               :         ( ).
+ *                               :   
+ *                           ,       ,  
+ *                            .       .
+ *                              ,   LcdPixel  .
+ *                            -8191..8191 (LINE_LIMIT,    ) 
+ *                            ,       
+ * ()           :  x1, y1  ->    
+ *                          x2, y2  ->    
+ *                          mode    -> Off, On  Xor.  enum  n3310.h
+ *   :      n3310lcd.h. OUT_OF_BORDER,  
+ *                             (    )
+ */
+byte LcdLine ( int x1, int y1, int x2, int y2, LcdPixelMode mode )
+{
+    int  dx, dy, stepx, stepy, fraction;
+    int  major, minor, kLo, kHi, mLo, mHi, k, m;
+    int  index;
+    byte x, y, nx, ny, start, bits;
+
+    //       long,        int
+    x1 = LcdLineClamp( (long)x1 + OriginX );
+    y1 = LcdLineClamp( (long)y1 + OriginY );
+    x2 = LcdLineClamp( (long)x2 + OriginX );
+    y2 = LcdLineClamp( (long)y2 + OriginY );
+
+    //      
+    if ( y1 == y2 || x1 == x2 )
+        return LcdClipBox( x1, y1, x2, y2, mode );
+
+    //        :   
+    if ( LcdOutCode( x1, y1 ) & LcdOutCode( x2, y2 ) ) return OUT_OF_BORDER;
+
+    // dy   y2 - y1
+    // -- = -------
+    // dx   x2 - x1
+
+    dy = y2 - y1;
+    dx = x2 - x1;
+
+    // dy 
+    if ( dy < 0 )
+    {
+        dy    = -dy;
+        stepy = -1;
+    }
+    else
+    {
+        stepy = 1;
+    }
+
+    // dx 
+    if ( dx < 0 )
+    {
+        dx    = -dx;
+        stepx = -1;
+    }
+    else
+    {
+        stepx = 1;
+    }
+
+    //      (major)  k = 0..major,      
+    //  minor .  ,       
+    if ( dx > dy )
+    {
+        major = dx;
+        minor = dy;
+        LcdClipSteps( x1, stepx, ClipX0, ClipX1, major, &kLo, &kHi );
+        LcdClipSteps( y1, stepy, ClipY0, ClipY1, minor, &mLo, &mHi );
+    }
+    else
+    {
+        major = dy;
+        minor = dx;
+        LcdClipSteps( y1, stepy, ClipY0, ClipY1, major, &kLo, &kHi );
+        LcdClipSteps( x1, stepx, ClipX0, ClipX1, minor, &mLo, &mHi );
+    }
+
+    //     m(k) = ( 2*k*minor + major ) / ( 2*major )  ,
+    //   mLo <= m(k) <= mHi    k
+    k = LcdMinorStep( mLo, major, minor );
+    if ( k > kLo ) kLo = k;
+
+    k = LcdMinorStep( mHi + 1, major, minor ) - 1;
+    if ( k < kHi ) kHi = k;
+
+    if ( kLo > kHi ) return OUT_OF_BORDER;
+
+    //       
+    m = ( 2L * kLo * minor + major ) / ( 2L * major );
+    fraction = 2 * minor - major + 2 * ( (long)kLo * minor - (long)m * major );
+
+    if ( dx > dy )
+    {
+        x = x1 + stepx * kLo;
+        y = y1 + stepy * m;
+    }
+    else
+    {
+        x = x1 + stepx * m;
+        y = y1 + stepy * kLo;
+    }
+
+    dx <<= 1;
+    dy <<= 1;
+
+    //  ,      (    ),
+    //    bits     .  
+    //      ,    
+    index = ( y / 8 ) * LCD_X_RES + x;
+    start = x;
+    bits  = 0;
+
+    for ( k = kLo; ; k++ )
+    {
+        bits |= 0x01 << ( y % 8 );
+
+        if ( k == kHi ) break;
+
+        //    
+        nx = x;
+        ny = y;
+
+        if ( dx > dy )
+        {
+            if ( fraction >= 0 )
+            {
+                ny += stepy;
+                fraction -= dx;
+            }
+            nx += stepx;
+            fraction += dy;
+        }
+        else
+        {
+            if ( fraction >= 0 )
+            {
+                nx += stepx;
+                fraction -= dy;
+            }
+            ny += stepy;
+            fraction += dx;
+        }
+
+        if ( nx != x || ny / 8 != y / 8 )
+        {
+            //    ,  
+            LcdMask( index, bits, mode );
+            bits = 0;
+
+            if ( ny / 8 != y / 8 )
+            {
+                LcdDirtyBank( y / 8, start, x );
+                start = nx;
+            }
+
+            index = ( ny / 8 ) * LCD_X_RES + nx;
+        }
+
+        x = nx;
+        y = ny;
+    }
+
+    LcdMask( index, bits, mode );
+    LcdDirtyBank( y / 8, start, x );
+
+    //    
+    UpdateLcd = TRUE;
+
+    return ( kLo > 0 || kHi < major ) ? OUT_OF_BORDER : OK;
+}
+
+
+
+/*
+ *                    :  LcdOutCode
+ *               :        ( - ):
+ *                              ,    
+ * ()           :  x, y ->   
+ *   :  0     
+ */
+static byte LcdOutCode ( int x, int y )
+{
+    byte code = 0;
+
+    if ( x < ClipX0 ) code |= 0x01;
+    if ( x > ClipX1 ) code |= 0x02;
+    if ( y < ClipY0 ) code |= 0x04;
+    if ( y > ClipY1 ) code |= 0x08;
+
+    return code;
+}
+
+
+
+/*
+ *                    :  LcdLineClamp
+ *               :        -LINE_LIMIT..LINE_LIMIT
+ * ()           :  v ->  
+ *   :    
+ */
+static int LcdLineClamp ( long v )
+{
+    if ( v < -LINE_LIMIT ) return -LINE_LIMIT;
+    if ( v > LINE_LIMIT ) return LINE_LIMIT;
+
+    return v;
+}
+
+
+
+/*
+ *                    :  LcdClipSteps
+ *               :    k = 0..count,    from + step * k
+ *                             lo..hi
+ * ()           :  from   ->  
+ *                          step   ->  (1  -1)
+ *                          lo, hi ->   
+ *                          count  ->  
+ *                          kLo    ->   
+ *                          kHi    ->    ( kLo,   )
+ *   :  
+ */
+static void LcdClipSteps ( int from, int step, int lo, int hi, int count, int *kLo, int *kHi )
+{
+    if ( step > 0 )
+    {
+        *kLo = lo - from;
+        *kHi = hi - from;
+    }
+    else
+    {
+        *kLo = from - hi;
+        *kHi = from - lo;
+    }
+
+    if ( *kLo < 0 ) *kLo = 0;
+    if ( *kHi > count ) *kHi = count;
+}
+
+
+
+/*
+ *                    :  LcdMinorStep
+ *               :      ,     
+ *                             m    
+ * ()           :  m     ->     
+ *                          major ->     
+ *                          minor ->      ( 0)
+ *   :   
+ */
+static int LcdMinorStep ( int m, int major, int minor )
+{
+    if ( m <= 0 ) return 0;
+
+    //  k,   2*k*minor + major >= 2*m*major
+    return ( ( 2L * m - 1 ) * major + 2L * minor - 1 ) / ( 2L * minor );
+}
+
+
+
+/*
+ *                    :  LcdMask
+ *               :         (   )
+ * ()           :  index ->    
+ *                          mask  -> ,   
+ *                          mode  -> Off, On  Xor.  enum  n3310.h
+ *   :  
+ */
+static void LcdMask ( int index, byte mask, LcdPixelMode mode )
+{
+    if ( mode == PIXEL_OFF )
+    {
+        LcdCache[ index ] &= ~mask;
+    }
+    else if ( mode == PIXEL_ON )
+    {
+        LcdCache[ index ] |= mask;
+    }
+    else if ( mode == PIXEL_XOR )
+    {
+        LcdCache[ index ] ^= mask;
+    }
+}
+
+
+
+/*
+ *                    :  LcdDirtyBank
+ *               :        x1..x2
+ * ()           :  bank   ->  
+ *                          x1, x2 ->    x (  )
+ *   :  
+ */
+static void LcdDirtyBank ( byte bank, byte x1, byte x2 )
+{
+    byte tmp;
+
+    if ( x1 > x2 )
+    {
+        tmp = x1; x1 = x2; x2 = tmp;
+    }
+
+    if ( x1 < DirtyLo[bank] )
+        DirtyLo[bank] = x1;
+
+    if ( x2 > DirtyHi[bank] )
+        DirtyHi[bank] = x2;
+}
+
+
+
+/*
+ *                    :  LcdHLine
+ *               :    .       
+ *                               ( LcdBox)
+ * ()           :  x1, x2 ->   x   (  )
+ *                          y      ->   y
+ *                          mode   -> Off, On  Xor.  enum  n3310.h
+ *   :      n3310lcd.h.    
+ *                            ,     OUT_OF_BORDER
+ */
+byte LcdHLine ( int x1, int x2, int y, LcdPixelMode mode )
+{
+    return LcdClipBox( x1 + OriginX, y + OriginY, x2 + OriginX, y + OriginY, mode );
+}
+
+
+
+/*
+ *                    :  LcdVLine
+ *               :    .       :
+ *                              ,     ( LcdBox)
+ * ()           :  x      ->   x
+ *                          y1, y2 ->   y   (  )
+ *                          mode   -> Off, On  Xor.  enum  n3310.h
+ *   :      n3310lcd.h.    
+ *                            ,     OUT_OF_BORDER
+ */
+byte LcdVLine ( int x, int y1, int y2, LcdPixelMode mode )
+{
+    return LcdClipBox( x + OriginX, y1 + OriginY, x + OriginX, y2 + OriginY, mode );
+}
+
+
+
+/*
+ *                    :  LcdCircle
+ *               :    ( ).      ,
+ *                             PIXEL_XOR        
+ * ()           :  x, y   ->   
+ *                          radius ->  
+ *                          mode   -> Off, On  Xor.  enum  n3310.h
+ *   :      n3310lcd.h. OUT_OF_BORDER,  
+ *                             (    )
+ */
+byte LcdCircle ( int x, int y, byte radius, LcdPixelMode mode )
+{
+    int xc = 0;
+    int yc = radius;
+    int p  = 3 - radius * 2;
+
+    x += OriginX;
+    y += OriginY;
+
+    //     
+    if ( x + radius < ClipX0 || x - radius > ClipX1 || y + radius < ClipY0 || y - radius > ClipY1 )
+        return OUT_OF_BORDER;
+
+    //    
+    if ( radius == 0 ) return LcdPlot( x, y, mode );
+
+    while ( xc <= yc )
+    {
+        //    (xc == 0)    (xc == yc)     
+        LcdPlot( x + xc, y + yc, mode );
+        LcdPlot( x - yc, y + xc, mode );
+        LcdPlot( x + yc, y - xc, mode );
+        LcdPlot( x - xc, y - yc, mode );
+
+        if ( xc != 0 && xc != yc )
+        {
+            LcdPlot( x - xc, y + yc, mode );
+            LcdPlot( x + yc, y + xc, mode );
+            LcdPlot( x - yc, y - xc, mode );
+            LcdPlot( x + xc, y - yc, mode );
+        }
+
+        if ( p < 0 )
+        {
+            p += xc * 4 + 6;
+        }
+        else
+        {
+            p += ( xc - yc ) * 4 + 10;
+            yc--;
+        }
+        xc++;
+    }
+
+    //    
+    UpdateLcd = TRUE;
+
+    if ( x - radius < ClipX0 || x + radius > ClipX1 || y - radius < ClipY0 || y + radius > ClipY1 )
+        return OUT_OF_BORDER;
+
+    return OK;
+}
+
+
+
+/*
+ *                    :  LcdFillCircle
+ *               :    .     ( LcdSpan):
+ *                               -  y +- xc,   y +- yc - 
+ *                          yc      .      ,
+ *                                 PIXEL_XOR
+ * ()           :  x, y   ->   
+ *                          radius ->  
+ *                          mode   -> Off, On  Xor.  enum  n3310.h
+ *   :      n3310lcd.h. OUT_OF_BORDER,  
+ *                             (    )
+ */
+byte LcdFillCircle ( int x, int y, byte radius, LcdPixelMode mode )
+{
+    int xc = 0;
+    int yc = radius;
+    int p  = 3 - radius * 2;
+
+    x += OriginX;
+    y += OriginY;
+
+    //     
+    if ( x + radius < ClipX0 || x - radius > ClipX1 || y + radius < ClipY0 || y - radius > ClipY1 )
+        return OUT_OF_BORDER;
+
+    while ( xc <= yc )
+    {
+        LcdSpan( x - yc, x + yc, y + xc, mode );
+
+        if ( xc != 0 )
+            LcdSpan( x - yc, x + yc, y - xc, mode );
+
+        if ( p < 0 )
+        {
+            p += xc * 4 + 6;
+        }
+        else
+        {
+            //  y +- yc    .  yc == xc,    
+            if ( yc != xc )
+            {
+                LcdSpan( x - xc, x + xc, y + yc, mode );
+                LcdSpan( x - xc, x + xc, y - yc, mode );
+            }
+
+            p += ( xc - yc ) * 4 + 10;
+            yc--;
+        }
+        xc++;
+    }
+
+    //        
+    return LcdDirtyBox( x - radius, y - radius, x + radius, y + radius );
+}
+
+
+
+/*
+ *                    :  LcdEllipse
+ *               :     ,    ( LcdOval).  
+ *                                  .  
+ *                             ,        PIXEL_XOR
+ * ()           :  x, y   ->   
+ *                          rx, ry ->   x   y
+ *                          mode   -> Off, On  Xor.  enum  n3310.h
+ *   :      n3310lcd.h. OUT_OF_BORDER,  
+ *                             (    )
+ */
+byte LcdEllipse ( int x, int y, byte rx, byte ry, LcdPixelMode mode )
+{
+    x += OriginX;
+    y += OriginY;
+
+    //     
+    if ( x + rx < ClipX0 || x - rx > ClipX1 || y + ry < ClipY0 || y - ry > ClipY1 )
+        return OUT_OF_BORDER;
+
+    LcdOval( x, x, y, y, rx, ry, FALSE, mode );
+
+    //        
+    return LcdDirtyBox( x - rx, y - ry, x + rx, y + ry );
+}
+
+
+
+/*
+ *                    :  LcdFillEllipse
+ *               :    ,      ( LcdOval)
+ * ()           :  x, y   ->   
+ *                          rx, ry ->   x   y
+ *                          mode   -> Off, On  Xor.  enum  n3310.h
+ *   :      n3310lcd.h. OUT_OF_BORDER,  
+ *                             (    )
+ */
+byte LcdFillEllipse ( int x, int y, byte rx, byte ry, LcdPixelMode mode )
+{
+    x += OriginX;
+    y += OriginY;
+
+    //     
+    if ( x + rx < ClipX0 || x - rx > ClipX1 || y + ry < ClipY0 || y - ry > ClipY1 )
+        return OUT_OF_BORDER;
+
+    LcdOval( x, x, y, y, rx, ry, TRUE, mode );
+
+    //        
+    return LcdDirtyBox( x - rx, y - ry, x + rx, y + ry );
+}
+
+
+
+/*
+ *                    :  LcdOval
+ *               :     (  )     
+ *                           LcdOvalRow    .  :  
+ *                            xl,   xr,   yt,   yb.   
+ *                          ,       
+ * ()           :  xl, xr ->       
+ *                          yt, yb ->       
+ *                          rx, ry ->   x   y
+ *                          fill   -> TRUE - , FALSE -  
+ *                          mode   -> Off, On  Xor.  enum  n3310.h
+ *   :  
+ */
+static void LcdOval ( int xl, int xr, int yt, int yb, byte rx, byte ry, byte fill, LcdPixelMode mode )
+{
+    long rx2 = (long)rx * rx;
+    long ry2 = (long)ry * ry;
+    long dx, dy, p;
+    int  x  = 0;
+    int  y  = ry;
+    int  xa = 0;
+
+    //   - 
+    if ( rx == 0 || ry == 0 )
+    {
+        for ( ; y >= 0; y-- )
+            LcdOvalRow( xl, xr, yt, yb, y, 0, rx, fill, mode );
+        return;
+    }
+
+    //  1:   , x    ,  ,   y
+    dx = 0;
+    dy = 2 * rx2 * y;
+    p  = ry2 - rx2 * ry + rx2 / 4;
+
+    while ( dx < dy )
+    {
+        if ( p < 0 )
+        {
+            x++;
+            dx += 2 * ry2;
+            p  += dx + ry2;
+        }
+        else
+        {
+            LcdOvalRow( xl, xr, yt, yb, y, xa, x, fill, mode );
+
+            x++;
+            y--;
+            xa  = x;
+            dx += 2 * ry2;
+            dy -= 2 * rx2;
+            p  += dx - dy + ry2;
+        }
+    }
+
+    //  2: y    .    (xa)    1
+    p = ry2 * ( (long)x * x + x ) + ry2 / 4 + rx2 * ( (long)( y - 1 ) * ( y - 1 ) - ry2 );
+
+    while ( y >= 0 )
+    {
+        LcdOvalRow( xl, xr, yt, yb, y, xa, x, fill, mode );
+
+        if ( p > 0 )
+        {
+            dy -= 2 * rx2;
+            p  += rx2 - dy;
+        }
+        else
+        {
+            x++;
+            dx += 2 * ry2;
+            dy -= 2 * rx2;
+            p  += dx - dy + rx2;
+        }
+        y--;
+        xa = x;
+    }
+}
+
+
+
+/*
+ *                    :  LcdOvalRow
+ *               :    y   ( LcdOval)    .
+ *                                ,  ,  
+ *                            (xa == 0),       xl..xr,  
+ *                              yt == yb -  
+ * ()           :  xl, xr ->       
+ *                          yt, yb ->       
+ *                          y      ->   
+ *                          xa, xb ->       
+ *                          fill   -> TRUE - , FALSE -  
+ *                          mode   -> Off, On  Xor.  enum  n3310.h
+ *   :  
+ */
+static void LcdOvalRow ( int xl, int xr, int yt, int yb, int y, int xa, int xb, byte fill, LcdPixelMode mode )
+{
+    if ( fill || xa == 0 )
+    {
+        LcdSpan( xl - xb, xr + xb, yt - y, mode );
+
+        if ( yt - y != yb + y )
+            LcdSpan( xl - xb, xr + xb, yb + y, mode );
+    }
+    else
+    {
+        LcdSpan( xl - xb, xl - xa, yt - y, mode );
+        LcdSpan( xr + xa, xr + xb, yt - y, mode );
+
+        if ( yt - y != yb + y )
+        {
+            LcdSpan( xl - xb, xl - xa, yb + y, mode );
+            LcdSpan( xr + xa, xr + xb, yb + y, mode );
+        }
+    }
+}
+
+
+
+/*
+ *                    :  LcdArc
+ *               :    ,    .   ,
+ *                          0 -  ,    .    startAngle
+ *                           endAngle    ( endAngle ,  0 ),
+ *                             360     .    ,
+ *                             LcdCircle,      ( LcdArcDot)
+ * ()           :  x, y       ->   
+ *                          radius     ->  
+ *                          startAngle ->   
+ *                          endAngle   ->   
+ *                          mode       -> Off, On  Xor.  enum  n3310.h
+ *   :      n3310lcd.h. OUT_OF_BORDER,   
+ *                             (    )
+ */
+byte LcdArc ( int x, int y, byte radius, int startAngle, int endAngle, LcdPixelMode mode )
+{
+    int arc [ 5 ];
+    int xc = 0;
+    int yc = radius;
+    int p  = 3 - radius * 2;
+
+    x += OriginX;
+    y += OriginY;
+
+    //     
+    if ( x + radius < ClipX0 || x - radius > ClipX1 || y + radius < ClipY0 || y - radius > ClipY1 )
+        return OUT_OF_BORDER;
+
+    //         
+    arc[0] = LcdSin( startAngle + 90 );
+    arc[1] = LcdSin( startAngle );
+    arc[2] = LcdSin( endAngle + 90 );
+    arc[3] = LcdSin( endAngle );
+    arc[4] = ( endAngle - startAngle >= 360 ) ? 360 : ( ( endAngle - startAngle ) % 360 + 360 ) % 360;
+
+    //    
+    if ( radius == 0 )
+    {
+        LcdArcDot( x, y, 0, 0, arc, mode );
+        return LcdDirtyBox( x, y, x, y );
+    }
+
+    while ( xc <= yc )
+    {
+        //    (xc == 0)    (xc == yc)     
+        LcdArcDot( x, y,  xc,  yc, arc, mode );
+        LcdArcDot( x, y, -yc,  xc, arc, mode );
+        LcdArcDot( x, y,  yc, -xc, arc, mode );
+        LcdArcDot( x, y, -xc, -yc, arc, mode );
+
+        if ( xc != 0 && xc != yc )
+        {
+            LcdArcDot( x, y, -xc,  yc, arc, mode );
+            LcdArcDot( x, y,  yc,  xc, arc, mode );
+            LcdArcDot( x, y, -yc, -xc, arc, mode );
+            LcdArcDot( x, y,  xc, -yc, arc, mode );
+        }
+
+        if ( p < 0 )
+        {
+            p += xc * 4 + 6;
+        }
+        else
+        {
+            p += ( xc - yc ) * 4 + 10;
+            yc--;
+        }
+        xc++;
+    }
+
+    //        
+    return LcdDirtyBox( x - radius, y - radius, x + radius, y + radius );
+}
+
+
+
+/*
+ *                    :  LcdArcDot
+ *               :    ,      .   
+ *                          :         
+ *                          ,         
+ * ()           :  x, y   ->   
+ *                          dx, dy ->     (y ,   )
+ *                          arc    ->    ,    ,   
+ *                          mode   -> Off, On  Xor.  enum  n3310.h
+ *   :  
+ */
+static void LcdArcDot ( int x, int y, int dx, int dy, const int *arc, LcdPixelMode mode )
+{
+    long start, end;
+
+    if ( arc[4] < 360 )
+    {
+        //   -       (  y  )
+        start = -( (long)arc[0] * dy + (long)arc[1] * dx );
+        end   = -( (long)arc[2] * dy + (long)arc[3] * dx );
+
+        if ( arc[4] <= 180 )
+        {
+            //       .       
+            if ( start < 0 || end > 0 ) return;
+            if ( arc[4] == 0 && (long)arc[0] * dx - (long)arc[1] * dy <= 0 ) return;
+        }
+        else
+        {
+            //       ,    
+            if ( start < 0 && end > 0 ) return;
+        }
+    }
+
+    x += dx;
+    y += dy;
+
+    if ( x < ClipX0 || x > ClipX1 || y < ClipY0 || y > ClipY1 ) return;
+
+    LcdMask( ( y / 8 ) * LCD_X_RES + x, 0x01 << ( y % 8 ), mode );
+}
+
+
+
+/*
+ *                    :  LcdSin
+ *               :           
+ * ()           :  angle ->   , 
+ *   :  ,   255
+ */
+static int LcdSin ( int angle )
+{
+    angle %= 360;
+    if ( angle < 0 ) angle += 360;
+
+    if ( angle <= 90 )  return  pgm_read_byte( &SinTable[ angle ] );
+    if ( angle <= 180 ) return  pgm_read_byte( &SinTable[ 180 - angle ] );
+    if ( angle <= 270 ) return -pgm_read_byte( &SinTable[ angle - 180 ] );
+
+    return -pgm_read_byte( &SinTable[ 360 - angle ] );
+}
+
+
+
+/*
+ *                    :  LcdRoundRect
+ *               :       .  - 
+ *                           ( LcdOval),        ,
+ *                            - .      
+ * ()           :  x1, y1 ->    
+ *                          x2, y2 ->    
+ *                          radius ->  ,     
+ *                          mode   -> Off, On  Xor.  enum  n3310.h
+ *   :      n3310lcd.h.    
+ *                            ,     OUT_OF_BORDER
+ */
+byte LcdRoundRect ( int x1, int y1, int x2, int y2, byte radius, LcdPixelMode mode )
+{
+    return LcdRoundBox( x1 + OriginX, y1 + OriginY, x2 + OriginX, y2 + OriginY, radius, FALSE, mode );
+}
+
+
+
+/*
+ *                    :  LcdFillRoundRect
+ *               :       
+ * ()           :  x1, y1 ->    
+ *                          x2, y2 ->    
+ *                          radius ->  ,     
+ *                          mode   -> Off, On  Xor.  enum  n3310.h
+ *   :      n3310lcd.h.    
+ *                            ,     OUT_OF_BORDER
+ */
+byte LcdFillRoundRect ( int x1, int y1, int x2, int y2, byte radius, LcdPixelMode mode )
+{
+    return LcdRoundBox( x1 + OriginX, y1 + OriginY, x2 + OriginX, y2 + OriginY, radius, TRUE, mode );
+}
+
+
+
+/*
+ *                    :  LcdRoundBox
+ *               :         .  
+ *                            ,     -  LcdClipBox
+ * ()           :  x1, y1 ->     
+ *                          x2, y2 ->     
+ *                          radius ->  
+ *                          fill   -> TRUE - , FALSE -  
+ *                          mode   -> Off, On  Xor.  enum  n3310.h
+ *   :  OK    ,  OUT_OF_BORDER
+ */
+static byte LcdRoundBox ( int x1, int y1, int x2, int y2, byte radius, byte fill, LcdPixelMode mode )
+{
+    int tmp;
+
+    if ( x1 > x2 )
+    {
+        tmp = x1; x1 = x2; x2 = tmp;
+    }
+
+    if ( y1 > y2 )
+    {
+        tmp = y1; y1 = y2; y2 = tmp;
+    }
+
+    //     
+    if ( x2 < ClipX0 || x1 > ClipX1 || y2 < ClipY0 || y1 > ClipY1 )
+        return OUT_OF_BORDER;
+
+    //    
+    if ( radius > ( x2 - x1 ) / 2 ) radius = ( x2 - x1 ) / 2;
+    if ( radius > ( y2 - y1 ) / 2 ) radius = ( y2 - y1 ) / 2;
+
+    LcdOval( x1 + radius, x2 - radius, y1 + radius, y2 - radius, radius, radius, fill, mode );
+
+    //    
+    if ( y2 - y1 > radius * 2 + 1 )
+    {
+        if ( fill )
+        {
+            LcdClipBox( x1, y1 + radius + 1, x2, y2 - radius - 1, mode );
+        }
+        else
+        {
+            LcdClipBox( x1, y1 + radius + 1, x1, y2 - radius - 1, mode );
+
+            if ( x2 != x1 )
+                LcdClipBox( x2, y1 + radius + 1, x2, y2 - radius - 1, mode );
+        }
+    }
+
+    //        
+    return LcdDirtyBox( x1, y1, x2, y2 );
+}
+
+
+
+/*
+ *                    :  LcdThickLine
+ *               :     width .  -    
+ *                             (     ),  
+ *                            1/16 .        
+ *                          ,          PIXEL_XOR.
+ *                               -   1000 
+ * ()           :  x1, y1 ->    
+ *                          x2, y2 ->    
+ *                          width  ->  , 0  1 -   ( LcdLine)
+ *                          mode   -> Off, On  Xor.  enum  n3310.h
+ *   :      n3310lcd.h. OUT_OF_BORDER,  
+ *                             (    )
+ */
+byte LcdThickLine ( int x1, int y1, int x2, int y2, byte width, LcdPixelMode mode )
+{
+    long  cx [ 4 ];
+    long  cy [ 4 ];
+    long  len, nx, ny, tx, ty, yq, xq, lo, hi;
+    long  xMin, xMax, yMin, yMax;
+    int   row, rowLo, rowHi;
+    byte  i, j;
+
+    if ( width <= 1 ) return LcdLine( x1, y1, x2, y2, mode );
+
+    x1 += OriginX;
+    y1 += OriginY;
+    x2 += OriginX;
+    y2 += OriginY;
+
+    //     -    width
+    if ( x1 == x2 && y1 == y2 )
+        return LcdClipBox( x1 - width / 2, y1 - width / 2, x1 - width / 2 + width - 1, y1 - width / 2 + width - 1, mode );
+
+    //    1/16 
+    len = LcdSqrt( ( (long)( x2 - x1 ) * ( x2 - x1 ) + (long)( y2 - y1 ) * ( y2 - y1 ) ) * 256 );
+
+    //        ,  1/16 
+    nx = -( (long)( y2 - y1 ) * width * 128 ) / len;
+    ny =  ( (long)( x2 - x1 ) * width * 128 ) / len;
+    tx =  ( (long)( x2 - x1 ) * 128 ) / len;
+    ty =  ( (long)( y2 - y1 ) * 128 ) / len;
+
+    //     
+    cx[0] = x1 * 16L - tx + nx;   cy[0] = y1 * 16L - ty + ny;
+    cx[1] = x2 * 16L + tx + nx;   cy[1] = y2 * 16L + ty + ny;
+    cx[2] = x2 * 16L + tx - nx;   cy[2] = y2 * 16L + ty - ny;
+    cx[3] = x1 * 16L - tx - nx;   cy[3] = y1 * 16L - ty - ny;
+
+    xMin = xMax = cx[0];
+    yMin = yMax = cy[0];
+
+    for ( i = 1; i < 4; i++ )
+    {
+        if ( cx[i] < xMin ) xMin = cx[i];
+        if ( cx[i] > xMax ) xMax = cx[i];
+        if ( cy[i] < yMin ) yMin = cy[i];
+        if ( cy[i] > yMax ) yMax = cy[i];
+    }
+
+    // ,      (   )
+    rowLo = LcdCeil16( yMin );
+    rowHi = LcdCeil16( yMax ) - 1;
+
+    for ( row = ( rowLo > ClipY0 ) ? rowLo : ClipY0; row <= rowHi && row <= ClipY1; row++ )
+    {
+        yq = row * 16L;
+        lo = xMax;
+        hi = xMin;
+
+        for ( i = 0; i < 4; i++ )
+        {
+            j = ( i + 1 ) & 3;
+
+            //    
+            if ( ( yq < cy[i] && yq < cy[j] ) || ( yq > cy[i] && yq > cy[j] ) ) continue;
+
+            if ( cy[i] == cy[j] )
+            {
+                //      
+                if ( cx[i] < lo ) lo = cx[i];
+                if ( cx[i] > hi ) hi = cx[i];
+                xq = cx[j];
+            }
+            else
+            {
+                xq = cx[i] + ( yq - cy[i] ) * ( cx[j] - cx[i] ) / ( cy[j] - cy[i] );
+            }
+
+            if ( xq < lo ) lo = xq;
+            if ( xq > hi ) hi = xq;
+        }
+
+        // ,     (   )
+        if ( lo < hi )
+            LcdSpan( LcdCeil16( lo ), LcdCeil16( hi ) - 1, row, mode );
+    }
+
+    //        
+    return LcdDirtyBox( LcdCeil16( xMin ), rowLo, LcdCeil16( xMax ) - 1, rowHi );
+}
+
+
+
+/*
+ *                    :  LcdCeil16
+ *               :     1/16      
+ * ()           :  value ->   1/16 
+ *   :    
+ */
+static int LcdCeil16 ( long value )
+{
+    return ( value >= 0 ) ? ( value + 15 ) / 16 : -( -value / 16 );
+}
+
+
+
+/*
+ *                    :  LcdSqrt
+ *               :     (,  )
+ * ()           :  value -> 
+ *   :   ,  
+ */
+static long LcdSqrt ( unsigned long value )
+{
+    unsigned long root = 0;
+    unsigned long bit  = 1UL << 30;
+
+    while ( bit > value ) bit >>= 2;
+
+    while ( bit != 0 )
+    {
+        if ( value >= root + bit )
+        {
+            value -= root + bit;
+            root   = ( root >> 1 ) + bit;
+        }
+        else
+        {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+
+    return root;
+}
+
+
+
+/*
+ *                    :  LcdFillPolygon
+ *               :         . 
+ *                          ,     ( -,   
+ *                             ).      
+ *                           :         ,
+ *                                (  PIXEL_XOR).   
+ *                              LCD_POLY_MAX_EDGES (    
+ *                             y   )
+ * ()           :  points ->     ,   
+ *                          count  ->  
+ *                          mode   -> Off, On  Xor.  enum  n3310.h
+ *   :      n3310lcd.h. OUT_OF_BORDER,  
+ *                             (    ), OUT_OF_MEMORY,  
+ *                           LCD_POLY_MAX_EDGES (   )
+ */
+byte LcdFillPolygon ( const LcdPoint *points, byte count, LcdPixelMode mode )
+{
+    LcdPolyEdge  edge [ LCD_POLY_MAX_EDGES ];
+    int          cross [ LCD_POLY_MAX_EDGES ];
+    LcdPolyEdge *e;
+    int          xMin, xMax, yMin, yMax;
+    int          x1, y1, x2, y2, tmp;
+    int          row, rowLo, rowHi;
+    long         t;
+    byte         i, j, edges, n;
+
+    if ( count < 3 ) return OK;
+
+    //  
+    xMin = xMax = points[0].x;
+    yMin = yMax = points[0].y;
+
+    for ( i = 1; i < count; i++ )
+    {
+        if ( points[i].x < xMin ) xMin = points[i].x;
+        if ( points[i].x > xMax ) xMax = points[i].x;
+        if ( points[i].y < yMin ) yMin = points[i].y;
+        if ( points[i].y > yMax ) yMax = points[i].y;
+    }
+
+    xMin += OriginX;
+    xMax += OriginX;
+    yMin += OriginY;
+    yMax += OriginY;
+
+    //  
+    rowLo = ( yMin > ClipY0 ) ? yMin : ClipY0;
+    rowHi = ( yMax - 1 < ClipY1 ) ? yMax - 1 : ClipY1;
+
+    //  :    ,  -    
+    edges = 0;
+
+    for ( i = 0; i < count; i++ )
+    {
+        j = ( i + 1 == count ) ? 0 : i + 1;
+
+        x1 = points[i].x + OriginX;
+        y1 = points[i].y + OriginY;
+        x2 = points[j].x + OriginX;
+        y2 = points[j].y + OriginY;
+
+        if ( y1 > y2 )
+        {
+            tmp = x1; x1 = x2; x2 = tmp;
+            tmp = y1; y1 = y2; y2 = tmp;
+        }
+
+        //    ,      
+        if ( y1 == y2 || y2 <= rowLo || y1 > rowHi ) continue;
+
+        if ( edges == LCD_POLY_MAX_EDGES ) return OUT_OF_MEMORY;
+
+        e = &edge[ edges++ ];
+
+        e->yTop = ( y1 > rowLo ) ? y1 : rowLo;
+        e->yBot = y2;
+        e->dy   = y2 - y1;
+
+        //    yTop: x1 + t / dy,    
+        t = (long)( e->yTop - y1 ) * ( x2 - x1 );
+        e->x   = x1 + LcdFloorDiv( t, e->dy );
+        e->rem = t - (long)( e->x - x1 ) * e->dy;
+
+        e->xStep   = LcdFloorDiv( x2 - x1, e->dy );
+        e->remStep = ( x2 - x1 ) - e->xStep * e->dy;
+    }
+
+    for ( row = rowLo; row <= rowHi; row++ )
+    {
+        //     ,  ,  
+        n = 0;
+
+        for ( i = 0; i < edges; i++ )
+        {
+            e = &edge[i];
+
+            if ( row < e->yTop || row >= e->yBot ) continue;
+
+            tmp = e->x + ( e->rem > 0 );
+
+            for ( j = n; j > 0 && cross[ j - 1 ] > tmp; j-- )
+                cross[j] = cross[ j - 1 ];
+
+            cross[j] = tmp;
+            n++;
+
+            //    
+            e->x   += e->xStep;
+            e->rem += e->remStep;
+
+            if ( e->rem >= e->dy )
+            {
+                e->rem -= e->dy;
+                e->x++;
+            }
+        }
+
+        //    
+        for ( i = 0; i + 1 < n; i += 2 )
+        {
+            LcdSpan( cross[i], cross[ i + 1 ] - 1, row, mode );
+        }
+    }
+
+    //        
+    return LcdDirtyBox( xMin, yMin, xMax - 1, yMax - 1 );
+}
+
+
+
+/*
+ *                    :  LcdFillTriangle
+ *               :     ( LcdFillPolygon)
+ * ()           :  x1, y1 ->    
+ *                          x2, y2 ->    
+ *                          x3, y3 ->    
+ *                          mode   -> Off, On  Xor.  enum  n3310.h
+ *   :      n3310lcd.h. OUT_OF_BORDER,  
+ *                             (    )
+ */
+byte LcdFillTriangle ( int x1, int y1, int x2, int y2, int x3, int y3, LcdPixelMode mode )
+{
+    LcdPoint points [ 3 ];
+
+    points[0].x = x1;
+    points[0].y = y1;
+    points[1].x = x2;
+    points[1].y = y2;
+    points[2].x = x3;
+    points[2].y = y3;
+
+    return LcdFillPolygon( points, 3, mode );
+}
+
+
+
+/*
+ *                    :  LcdFloorDiv
+ *               :      (       )
+ * ()           :  a -> 
+ *                          b -> ,  
+ *   :  ,  
+ */
+static int LcdFloorDiv ( long a, int b )
+{
+    return ( a >= 0 ) ? a / b : -( ( -a + b - 1 ) / b );
+}
+
+
+
+/*
+ *                    :  LcdFloodFill
+ *               :   ,     x, y:     ,   ,
+ *                                 (   
+ *                            ).  -       .
+ *                              ( ):   ,
+ *                                ,   .  
+ *                             .        LCD_FLOOD_STACK; 
+ *                            ,    ,      
+ * ()           :  x, y ->     
+ *                          mode -> Off, On  Xor. On   , Off  ,
+ *                                  Xor    
+ *   :      n3310lcd.h. OUT_OF_BORDER,    
+ *                          , OUT_OF_MEMORY,         
+ */
+byte LcdFloodFill ( int x, int y, LcdPixelMode mode )
+{
+    LcdFloodSeg  stack [ LCD_FLOOD_STACK ];
+    byte         depth = 0;
+    byte         target;
+    byte         response = OK;
+    int          x1, x2, l, dy;
+    int          xMin = LCD_X_RES, xMax = -1, yMin = LCD_Y_RES, yMax = -1;
+
+#ifdef LCD_FLOOD_STATS
+    FloodPeak = 0;
+#endif
+
+    x += OriginX;
+    y += OriginY;
+
+    if ( x < ClipX0 || x > ClipX1 || y < ClipY0 || y > ClipY1 ) return OUT_OF_BORDER;
+
+    //  .    ,  - 
+    target = LcdPeek( x, y );
+
+    if ( ( mode == PIXEL_ON && target ) || ( mode == PIXEL_OFF && !target ) ) return OK;
+
+    //       .      
+    LcdFloodPush( stack, &depth, y, x, x, 1 );
+    LcdFloodPush( stack, &depth, y + 1, x, x, -1 );
+
+    while ( depth > 0 )
+    {
+        //  x1..x2  ,    (  )  y
+        depth--;
+        dy = stack[ depth ].dy;
+        y  = stack[ depth ].y + dy;
+        x1 = stack[ depth ].xl;
+        x2 = stack[ depth ].xr;
 
-    //  PIXEL_OFF
-    if ( mode == PIXEL_OFF )
+        x = x1;
+
+        while ( x <= x2 )
+        {
+            //    
+            if ( LcdPeek( x, y ) != target )
+            {
+                x++;
+                continue;
+            }
+
+            //   .  x1      
+            l = x;
+
+            if ( x == x1 )
+            {
+                while ( l > ClipX0 && LcdPeek( l - 1, y ) == target ) l--;
+            }
+
+            while ( x < ClipX1 && LcdPeek( x + 1, y ) == target ) x++;
+
+            LcdSpan( l, x, y, mode );
+
+            if ( l < xMin ) xMin = l;
+            if ( x > xMax ) xMax = x;
+            if ( y < yMin ) yMin = y;
+            if ( y > yMax ) yMax = y;
+
+            //      ,     x1..x2 -   
+            if ( !LcdFloodPush( stack, &depth, y, l, x, dy ) )
+                response = OUT_OF_MEMORY;
+
+            if ( l < x1 && !LcdFloodPush( stack, &depth, y, l, x1 - 1, -dy ) )
+                response = OUT_OF_MEMORY;
+
+            if ( x > x2 && !LcdFloodPush( stack, &depth, y, x2 + 1, x, -dy ) )
+                response = OUT_OF_MEMORY;
+
+            //  x + 1   
+            x += 2;
+        }
+    }
+
+    //        
+    if ( xMax >= 0 ) LcdDirtyBox( xMin, yMin, xMax, yMax );
+
+    return response;
+}
+
+
+
+/*
+ *                    :  LcdFloodPush
+ *               :       ,       
+ * ()           :  stack  ->  
+ *                          depth  ->      
+ *                          y      ->    
+ *                          xl, xr ->    
+ *                          dy     ->    : 1 , -1 
+ *   :  FALSE,      ,  TRUE
+ */
+static byte LcdFloodPush ( LcdFloodSeg *stack, byte *depth, int y, int xl, int xr, int dy )
+{
+    //     
+    if ( y + dy < ClipY0 || y + dy > ClipY1 ) return TRUE;
+
+    if ( *depth == LCD_FLOOD_STACK ) return FALSE;
+
+    stack[ *depth ].y  = y;
+    stack[ *depth ].xl = xl;
+    stack[ *depth ].xr = xr;
+    stack[ *depth ].dy = dy;
+    ( *depth )++;
+
+#ifdef LCD_FLOOD_STATS
+    if ( *depth > FloodPeak ) FloodPeak = *depth;
+#endif
+
+    return TRUE;
+}
+
+
+
+#ifdef LCD_FLOOD_STATS
+
+/*
+ *                    :  LcdFloodPeak
+ *               :         LcdFloodFill.
+ *                             LCD_FLOOD_STACK,     ( OUT_OF_MEMORY)
+ * ()           :  
+ *   :   
+ */
+byte LcdFloodPeak ( void )
+{
+    return FloodPeak;
+}
+
+#endif
+
+
+
+/*
+ *                    :  LcdPeek
+ *               :     
+ * ()           :  x, y ->    (  )
+ *   :  1   ,  0
+ */
+static byte LcdPeek ( int x, int y )
+{
+    return ( LcdCache[ ( y / 8 ) * LCD_X_RES + x ] >> ( y % 8 ) ) & 0x01;
+}
+
+
+
+/*
+ *                    :  LcdSingleBar
+ *               :     
+ * ()           :  baseX  ->   x (  )
+ *                          baseY  ->   y (  )
+ *                          height ->  ( )
+ *                          width  ->  ( )
+ *                          mode   -> Off, On  Xor.  enum  n3310.h
+ *   :      n3310lcd.h.    
+ *                            ,     OUT_OF_BORDER
+ */
+byte LcdSingleBar ( int baseX, int baseY, byte height, byte width, LcdPixelMode mode )
+{
+    if ( height == 0 || width == 0 ) return OK;
+
+    baseX += OriginX;
+    baseY += OriginY;
+
+    return LcdClipBox( baseX, baseY - height + 1, baseX + width - 1, baseY, mode );
+}
+
+
+
+/*
+ *                    :  LcdBars
+ *               :      (  PIXEL_ON)
+ * ()           :  data[]     ->    
+ *                          numbBars   ->  
+ *                          width      ->  ( )
+ *                          multiplier ->   
+ *   :      n3310lcd.h
+ *             :     EMPTY_SPACE_BARS, BAR_X, BAR_Y  n3310.h
+ *                 :  byte example[5] = {1, 2, 3, 4, 5};
+ *                          LcdBars(example, 5, 3, 2);
+ */
+byte LcdBars ( byte data[], byte numbBars, byte width, byte multiplier )
+{
+    byte b;
+    int  tmpIdx;
+    byte response = OK;
+
+    for ( b = 0;  b < numbBars ; b++ )
     {
-        data &= ( ~( 0x01 << offset ) );
+        //   x
+        tmpIdx = ((width + EMPTY_SPACE_BARS) * b) + BAR_X;
+
+        //   .      
+        if ( LcdSingleBar( tmpIdx, BAR_Y, data[b] * multiplier, width, PIXEL_ON ) == OUT_OF_BORDER )
+            response = OUT_OF_BORDER;
     }
-    //  PIXEL_ON
-    else if ( mode == PIXEL_ON )
+
+    return response;
+}
+
+
+
+/*
+ *                    :  LcdRect
+ *               :    
+ * ()           :  x1    ->   x   
+ *                          y1    ->   y   
+ *                          x2    ->   x   
+ *                          y2    ->   y   
+ *                          mode  -> Off, On  Xor.  enum  n3310.h
+ *   :      n3310lcd.h.    
+ *                            ,     OUT_OF_BORDER
+ */
+byte LcdRect ( int x1, int y1, int x2, int y2, LcdPixelMode mode )
+{
+    byte response = OK;
+
+    if ( ( x2 > x1 ) && ( y2 > y1 ) )
     {
-        data |= ( 0x01 << offset );
+        x1 += OriginX;
+        y1 += OriginY;
+        x2 += OriginX;
+        y2 += OriginY;
+
+        //   
+        response |= LcdClipBox( x1, y1, x2, y1, mode );
+        response |= LcdClipBox( x1, y2, x2, y2, mode );
+
+        //     ,    PIXEL_XOR   
+        if ( y2 - y1 > 1 )
+        {
+            response |= LcdClipBox( x1, y1 + 1, x1, y2 - 1, mode );
+            response |= LcdClipBox( x2, y1 + 1, x2, y2 - 1, mode );
+        }
     }
-    //  PIXEL_XOR
-    else if ( mode  == PIXEL_XOR )
+    return response;
+}
+
+
+
+/*
+ *                    :  LcdFillRect
+ *               :    
+ * ()           :  x1    ->   x   
+ *                          y1    ->   y   
+ *                          x2    ->   x   
+ *                          y2    ->   y   
+ *                          mode  -> Off, On  Xor.  enum  n3310.h
+ *   :      n3310lcd.h.    
+ *                            ,     OUT_OF_BORDER
+ */
+byte LcdFillRect ( int x1, int y1, int x2, int y2, LcdPixelMode mode )
+{
+    return LcdClipBox( x1 + OriginX, y1 + OriginY, x2 + OriginX, y2 + OriginY, mode );
+}
+
+
+
+/*
+ *                    :  LcdClipBox
+ *               :          ( LcdBox)
+ * ()           :  x1, y1 ->     
+ *                          x2, y2 ->     
+ *                          mode   -> Off, On  Xor.  enum  n3310.h
+ *   :  OK    ,  OUT_OF_BORDER
+ */
+static byte LcdClipBox ( int x1, int y1, int x2, int y2, LcdPixelMode mode )
+{
+    int  tmp;
+    byte response = OK;
+
+    //       
+    if ( x1 > x2 )
     {
-        data ^= ( 0x01 << offset );
+        tmp = x1; x1 = x2; x2 = tmp;
+    }
+
+    if ( y1 > y2 )
+    {
+        tmp = y1; y1 = y2; y2 = tmp;
+    }
+
+    if ( x2 < ClipX0 || x1 > ClipX1 || y2 < ClipY0 || y1 > ClipY1 ) return OUT_OF_BORDER;
+
+    if ( x1 < ClipX0 ) { x1 = ClipX0; response = OUT_OF_BORDER; }
+    if ( x2 > ClipX1 ) { x2 = ClipX1; response = OUT_OF_BORDER; }
+    if ( y1 < ClipY0 ) { y1 = ClipY0; response = OUT_OF_BORDER; }
+    if ( y2 > ClipY1 ) { y2 = ClipY1; response = OUT_OF_BORDER; }
+
+    LcdBox( x1, y1, x2, y2, mode );
+
+    //    
+    UpdateLcd = TRUE;
+    return response;
+}
+
+
+
+/*
+ *                    :  LcdBox
+ *               :      ,    .   
+ *                            x1..x2    :      
+ *                            ,      .
+ *                                
+ * ()           :  x1, y1 ->    (  )
+ *                          x2, y2 ->    (x2 >= x1, y2 >= y1,   )
+ *                          mode   -> Off, On  Xor.  enum  n3310.h
+ *   :  
+ */
+static void LcdBox ( byte x1, byte y1, byte x2, byte y2, LcdPixelMode mode )
+{
+    byte  bank, last, mask, n;
+    byte *ptr, *end;
+
+    last = y2 / 8;
+    n    = x2 - x1 + 1;
+
+    for ( bank = y1 / 8; bank <= last; bank++ )
+    {
+        //   ,   
+        mask = LcdRowMask( bank, y1, y2 );
+
+        ptr = &LcdCache[ bank * LCD_X_RES + x1 ];
+        end = ptr + n;
+
+        if ( mask == 0xFF && mode == PIXEL_ON )
+        {
+            memset( ptr, 0xFF, n );
+        }
+        else if ( mask == 0xFF && mode == PIXEL_OFF )
+        {
+            memset( ptr, 0x00, n );
+        }
+        else if ( mode == PIXEL_OFF )
+        {
+            mask = ~mask;
+            while ( ptr != end ) *ptr++ &= mask;
+        }
+        else if ( mode == PIXEL_ON )
+        {
+            while ( ptr != end ) *ptr++ |= mask;
+        }
+        else if ( mode == PIXEL_XOR )
+        {
+            while ( ptr != end ) *ptr++ ^= mask;
+        }
+
+        if ( x1 < DirtyLo[bank] )
+            DirtyLo[bank] = x1;
+
+        if ( x2 > DirtyHi[bank] )
+            DirtyHi[bank] = x2;
+    }
+}
+
+
+
+/*
+ *                    :  LcdRowMask
+ *               :    ,    y1..y2
+ * ()           :  bank   ->  
+ *                          y1, y2 ->      (y1 <= y2,    )
+ *   :  ,  0    
+ */
+static byte LcdRowMask ( byte bank, int y1, int y2 )
+{
+    int  top  = bank * 8;
+    byte mask = 0xFF;
+
+    if ( y2 < top || y1 > top + 7 ) return 0x00;
+
+    if ( y1 > top )
+        mask &= 0xFF << ( y1 - top );
+
+    if ( y2 < top + 7 )
+        mask &= 0xFF >> ( top + 7 - y2 );
+
+    return mask;
+}
+
+
+
+/*
+ *                    :  LcdImage
+ *               :        Flash ROM.  
+ *                                   .
+ *                                
+ * ()           :     
+ *   :  
+ */
+void LcdImage ( const byte *imageData )
+{
+    if ( OriginX == 0 && OriginY == 0 && ClipX0 == 0 && ClipY0 == 0
+      && ClipX1 == LCD_X_RES - 1 && ClipY1 == LCD_Y_RES - 1 )
+    {
+//    //   
+//    LcdCacheIdx = 0;
+//    //   
+//    for ( LcdCacheIdx = 0; LcdCacheIdx < LCD_CACHE_SIZE; LcdCacheIdx++ )
+//    {
+//        //      
+//        LcdCache[LcdCacheIdx] = pgm_read_byte( imageData++ );
+//    }
+    
+        //   Jakub Lasinski (March 14 2009)
+        memcpy_P( LcdCache, imageData, LCD_CACHE_SIZE );  //     ,       
+
+        //      
+        LcdDirty( 0, LCD_CACHE_SIZE - 1 );
+
+        //    
+        UpdateLcd = TRUE;
+        return;
     }
 
-    //     
-    LcdCache[ index ] = data;
+    //    ,     ( LcdFBlit)
+    LcdFBlit( imageData, LCD_X_RES, LCD_Y_RES, 0, 0, ROP_COPY, NULL );
+}
+
+
+
+/*
+ *                    :  LcdBlit
+ *               :          ( LcdBlitMem)
+ * ()           :  src  -> : (h + 7) / 8   w ,    (  -  )
+ *                          w, h ->      
+ *                          x, y ->     
+ *                          rop  ->    .  enum  n3310.h
+ *                          mask ->       (1 -   ,
+ *                                  0 -     )  NULL
+ *   :      n3310lcd.h.    
+ *                            ,     OUT_OF_BORDER
+ */
+byte LcdBlit ( const byte *src, byte w, byte h, int x, int y, LcdRop rop, const byte *mask )
+{
+    if ( w == 0 || h == 0 ) return OK;
+
+    x += OriginX;
+    y += OriginY;
+
+    LcdBlitMem( src, w, h, x, y, rop, mask, FALSE );
+
+    //        
+    return LcdDirtyBox( x, y, x + w - 1, y + h - 1 );
+}
+
+
+
+/*
+ *                    :  LcdFBlit
+ *               :     Flash ROM     ( LcdBlitMem)
+ * ()           :  src  ->   Flash ROM: (h + 7) / 8   w ,   
+ *                          w, h ->      
+ *                          x, y ->     
+ *                          rop  ->    .  enum  n3310.h
+ *                          mask ->    Flash ROM      NULL
+ *   :      n3310lcd.h.    
+ *                            ,     OUT_OF_BORDER
+ */
+byte LcdFBlit ( const byte *src, byte w, byte h, int x, int y, LcdRop rop, const byte *mask )
+{
+    if ( w == 0 || h == 0 ) return OK;
+
+    x += OriginX;
+    y += OriginY;
+
+    LcdBlitMem( src, w, h, x, y, rop, mask, TRUE );
+
+    //        
+    return LcdDirtyBox( x, y, x + w - 1, y + h - 1 );
+}
+
+
+
+/*
+ *                    :  LcdBlitMem
+ *               :      .      
+ *                           ,        ,    
+ *                            - .    (   )
+ *                              ,     ,  .
+ *                                  (ROP_COPY  ),
+ *                             ,   n3310_digits.h   
+ * ()           :  src   ->  ( LcdBlit)
+ *                          w, h  ->      
+ *                          x, y  ->     
+ *                          rop   ->    .  enum  n3310.h
+ *                          mask  ->    NULL
+ *                          flash -> TRUE -     Flash ROM, FALSE -  
+ *   :  .    ,    ( LcdDirtyBox)
+ */
+static void LcdBlitMem ( const byte *src, byte w, byte h, int x, int y, LcdRop rop, const byte *mask, byte flash )
+{
+    const byte *s0, *s1, *m0, *m1;
+    byte        bank, rows, shift, data, opaque;
+    byte       *ptr;
+    int         x1, x2, col, sb;
+
+    //  
+    x1 = ( x > ClipX0 ) ? x : ClipX0;
+    x2 = ( x + w - 1 < ClipX1 ) ? x + w - 1 : ClipX1;
+
+    if ( x1 > x2 || y + h - 1 < ClipY0 || y > ClipY1 ) return;
+
+    for ( bank = ClipY0 / 8; bank <= ClipY1 / 8; bank++ )
+    {
+        //  ,     
+        rows = LcdRowMask( bank, ClipY0, ClipY1 ) & LcdRowMask( bank, y, y + h - 1 );
+        if ( !rows ) continue;
+
+        //  ,        ,  .
+        //   (sb + 1)   .    ,    rows
+        sb    = bank * 8 - y;
+        shift = sb & 7;
+        sb    = ( sb - shift ) / 8;
+
+        s0 = ( sb >= 0 && sb * 8 < h ) ? src + sb * w : NULL;
+        s1 = ( shift && ( sb + 1 ) * 8 < h ) ? src + ( sb + 1 ) * w : NULL;
+        m0 = ( mask && s0 ) ? mask + sb * w : NULL;
+        m1 = ( mask && s1 ) ? mask + ( sb + 1 ) * w : NULL;
+
+        ptr = &LcdCache[ bank * LCD_X_RES + x1 ];
+
+        //       :      
+        if ( rop == ROP_COPY && !mask && !shift && rows == 0xFF )
+        {
+            if ( flash )
+                memcpy_P( ptr, s0 + x1 - x, x2 - x1 + 1 );
+            else
+                memcpy( ptr, s0 + x1 - x, x2 - x1 + 1 );
+
+            continue;
+        }
+
+        // col -  
+        for ( col = x1 - x; col <= x2 - x; col++, ptr++ )
+        {
+            data   = 0;
+            opaque = mask ? 0 : 0xFF;
+
+            if ( s0 )
+            {
+                data = LcdSrcByte( s0 + col, flash ) >> shift;
+                if ( m0 ) opaque = LcdSrcByte( m0 + col, flash ) >> shift;
+            }
+
+            if ( s1 )
+            {
+                data |= LcdSrcByte( s1 + col, flash ) << ( 8 - shift );
+                if ( m1 ) opaque |= LcdSrcByte( m1 + col, flash ) << ( 8 - shift );
+            }
 
-    if ( index < LoWaterMark )
-    {
-        //   
-        LoWaterMark = index;
-    }
+            //     
+            opaque &= rows;
+            data   &= opaque;
 
-    if ( index > HiWaterMark )
-    {
-        //   
-        HiWaterMark = index;
+            switch ( rop )
+            {
+                case ROP_COPY:   *ptr = ( *ptr & ~opaque ) | data;  break;
+                case ROP_OR:     *ptr |= data;                      break;
+                case ROP_AND:    *ptr &= data | ~opaque;            break;
+                case ROP_XOR:    *ptr ^= data;                      break;
+                case ROP_ANDNOT: *ptr &= ~data;                     break;
+            }
+        }
     }
-    return OK;
 }
 
 
 
 /*
- *                    :  LcdLine
- *               :         ( )
- * ()           :  x1, y1  ->    
- *                          x2, y2  ->    
- *                          mode    -> Off, On  Xor.  enum  n3310.h
- *   :      n3310lcd.h
+ *                    :  LcdSrcByte
+ *               :         Flash ROM
+ * ()           :  ptr   ->  
+ *                          flash -> TRUE - Flash ROM, FALSE - 
+ *   :   
  */
-byte LcdLine ( byte x1, byte y1, byte x2, byte y2, LcdPixelMode mode )
+static byte LcdSrcByte ( const byte *ptr, byte flash )
 {
-    int dx, dy, stepx, stepy, fraction;
-    byte response;
+    return flash ? pgm_read_byte( ptr ) : *ptr;
+}
 
-    // dy   y2 - y1
-    // -- = -------
-    // dx   x2 - x1
 
-    dy = y2 - y1;
-    dx = x2 - x1;
 
-    // dy 
-    if ( dy < 0 )
-    {
-        dy    = -dy;
-        stepy = -1;
-    }
-    else
-    {
-        stepy = 1;
-    }
+#ifdef LCD_SPRITES
 
-    // dx 
-    if ( dx < 0 )
+/*
+ *                    :  LcdSpriteShow
+ *               :          x, y ( LcdSpritePlace).
+ *                             ,     
+ * ()           :  id    ->  ,  0  LCD_SPRITES - 1
+ *                          image ->   Flash ROM   LcdFBlit
+ *                          mask  ->    Flash ROM  NULL ( -  )
+ *                          w, h  ->   ,   LCD_SPRITE_MAX_W  LCD_SPRITE_MAX_H
+ *                          x, y  ->     
+ *   :      n3310lcd.h. OUT_OF_BORDER,   
+ *                           , OUT_OF_MEMORY,         
+ */
+byte LcdSpriteShow ( byte id, const byte *image, const byte *mask, byte w, byte h, int x, int y )
+{
+    LcdSprite *s;
+
+    if ( id >= LCD_SPRITES || w > LCD_SPRITE_MAX_W || h > LCD_SPRITE_MAX_H ) return OUT_OF_MEMORY;
+
+    s = &Sprites[id];
+
+    return LcdSpritePlace( s, image, mask, w, h, x + OriginX, y + OriginY );
+}
+
+
+
+/*
+ *                    :  LcdSpriteMove
+ *               :      x, y,  ,    
+ * ()           :  id   ->  
+ *                          x, y ->     
+ *   :      n3310lcd.h. OUT_OF_BORDER,   
+ *                           , OUT_OF_MEMORY,    
+ */
+byte LcdSpriteMove ( byte id, int x, int y )
+{
+    LcdSprite *s;
+
+    if ( id >= LCD_SPRITES || !Sprites[id].image ) return OUT_OF_MEMORY;
+
+    s = &Sprites[id];
+
+    return LcdSpritePlace( s, s->image, s->mask, s->w, s->h, x + OriginX, y + OriginY );
+}
+
+
+
+/*
+ *                    :  LcdSpriteHide
+ *               :   ,    
+ * ()           :  id ->  
+ *   :  
+ */
+void LcdSpriteHide ( byte id )
+{
+    LcdSprite *s;
+
+    if ( id >= LCD_SPRITES || !Sprites[id].visible ) return;
+
+    s = &Sprites[id];
+
+    LcdSpritePlace( s, NULL, s->mask, s->w, s->h, s->x, s->y );
+}
+
+
+
+/*
+ *                    :  LcdSpritePlace
+ *               :        ,      
+ *                            ( LcdBlitMem).      ,
+ *                            ,    :    - 
+ *                              ,    -    .
+ *                                LcdUpdate      .
+ *                                ,    
+ * ()           :  s     -> 
+ *                          image ->    NULL,   
+ *                          mask  ->     NULL
+ *                          w, h  ->    
+ *                          x, y  ->    
+ *   :  OK    ,  OUT_OF_BORDER
+ */
+static byte LcdSpritePlace ( LcdSprite *s, const byte *image, const byte *mask, byte w, byte h, int x, int y )
+{
+    byte  prev [ LCD_SPRITE_SAVE ];
+    byte  oldOn, newOn, bank, bLo, bHi, data;
+    byte  o [ 4 ];   //  : x1, x2, bank1, bank2
+    byte  n [ 4 ];   //  
+    int   lo, hi, col, cLo, cHi;
+
+    //  : ,    ,   
+    oldOn = s->visible && LcdSpriteArea( s->x, s->y, s->w, s->h, o );
+
+    if ( oldOn )
     {
-        dx    = -dx;
-        stepx = -1;
+        LcdSpriteCopy( prev, o, FALSE );
+        LcdSpriteCopy( s->save, o, TRUE );
     }
-    else
+
+    s->image   = image ? image : s->image;
+    s->mask    = mask;
+    s->w       = w;
+    s->h       = h;
+    s->x       = x;
+    s->y       = y;
+    s->visible = ( image != NULL );
+
+    //  :     
+    newOn = s->visible && LcdSpriteArea( x, y, w, h, n );
+
+    if ( newOn )
     {
-        stepx = 1;
+        LcdSpriteCopy( s->save, n, FALSE );
+        LcdBlitMem( image, w, h, x, y, ROP_COPY, mask, TRUE );
     }
 
-    dx <<= 1;
-    dy <<= 1;
+    if ( !oldOn && !newOn ) return OUT_OF_BORDER;
 
-    //   
-    response = LcdPixel( x1, y1, mode );
-    if(response)
-        return response;
+    if ( !oldOn ) { o[0] = n[0]; o[1] = n[1]; o[2] = n[2]; o[3] = n[3]; }
+    if ( !newOn ) { n[0] = o[0]; n[1] = o[1]; n[2] = o[2]; n[3] = o[3]; }
 
-    //     
-    if ( dx > dy )
+    //     
+    bLo = ( o[2] < n[2] ) ? o[2] : n[2];
+    bHi = ( o[3] > n[3] ) ? o[3] : n[3];
+    cLo = ( o[0] < n[0] ) ? o[0] : n[0];
+    cHi = ( o[1] > n[1] ) ? o[1] : n[1];
+
+    for ( bank = bLo; bank <= bHi; bank++ )
     {
-        fraction = dy - ( dx >> 1);
-        while ( x1 != x2 )
+        lo = LCD_X_RES;
+        hi = -1;
+
+        for ( col = cLo; col <= cHi; col++ )
         {
-            if ( fraction >= 0 )
+            //      
+            if ( oldOn && bank >= o[2] && bank <= o[3] && col >= o[0] && col <= o[1] )
+                data = prev[ ( bank - o[2] ) * ( o[1] - o[0] + 1 ) + col - o[0] ];
+            else if ( newOn && bank >= n[2] && bank <= n[3] && col >= n[0] && col <= n[1] )
+                data = s->save[ ( bank - n[2] ) * ( n[1] - n[0] + 1 ) + col - n[0] ];
+            else
+                continue;
+
+            if ( LcdCache[ bank * LCD_X_RES + col ] != data )
             {
-                y1 += stepy;
-                fraction -= dx;
+                if ( col < lo ) lo = col;
+                hi = col;
             }
-            x1 += stepx;
-            fraction += dy;
-
-            response = LcdPixel( x1, y1, mode );
-            if(response)
-                return response;
-
         }
-    }
-    else
-    {
-        fraction = dx - ( dy >> 1);
-        while ( y1 != y2 )
+
+        if ( lo <= hi )
         {
-            if ( fraction >= 0 )
-            {
-                x1 += stepx;
-                fraction -= dy;
-            }
-            y1 += stepy;
-            fraction += dx;
+            LcdDirtyBank( bank, lo, hi );
 
-            response = LcdPixel( x1, y1, mode );
-            if(response)
-                return response;
+            //    
+            UpdateLcd = TRUE;
         }
     }
 
-    //    
-    UpdateLcd = TRUE;
+    if ( !newOn ) return s->visible ? OUT_OF_BORDER : OK;
+
+    if ( x < ClipX0 || x + w - 1 > ClipX1 || y < ClipY0 || y + h - 1 > ClipY1 ) return OUT_OF_BORDER;
+
     return OK;
 }
 
 
 
 /*
- *                    :  LcdCircle
- *               :    ( )
- * ()           :  x, y   ->   
- *                          radius ->  
- *                          mode   -> Off, On  Xor.  enum  n3310.h
- *   :      n3310lcd.h
+ *                    :  LcdSpriteArea
+ *               :    ,   ,   
+ * ()           :  x, y  ->      
+ *                          w, h  ->    
+ *                          area  ->      ,    
+ *   :  FALSE      ,  TRUE
  */
-byte LcdCircle(byte x, byte y, byte radius, LcdPixelMode mode)
+static byte LcdSpriteArea ( int x, int y, byte w, byte h, byte *area )
 {
-    signed char xc = 0;
-    signed char yc = 0;
-    signed char p = 0;
+    if ( w == 0 || h == 0 || x > LCD_X_RES - 1 || x + w - 1 < 0 || y > LCD_Y_RES - 1 || y + h - 1 < 0 )
+        return FALSE;
+
+    area[0] = ( x > 0 ) ? x : 0;
+    area[1] = ( x + w - 1 < LCD_X_RES - 1 ) ? x + w - 1 : LCD_X_RES - 1;
+    area[2] = ( ( y > 0 ) ? y : 0 ) / 8;
+    area[3] = ( ( y + h - 1 < LCD_Y_RES - 1 ) ? y + h - 1 : LCD_Y_RES - 1 ) / 8;
+
+    return TRUE;
+}
 
-    if ( x >= LCD_X_RES || y >= LCD_Y_RES) return OUT_OF_BORDER;
 
-    yc = radius;
-    p = 3 - (radius<<1);
-    while (xc <= yc)  
+
+/*
+ *                    :  LcdSpriteCopy
+ *               :         (  )  
+ * ()           :  buf     -> 
+ *                          area    ->    ( LcdSpriteArea)
+ *                          toCache -> TRUE -    , FALSE -    
+ *   :  
+ */
+static void LcdSpriteCopy ( byte *buf, const byte *area, byte toCache )
+{
+    byte bank;
+    byte width = area[1] - area[0] + 1;
+
+    for ( bank = area[2]; bank <= area[3]; bank++, buf += width )
     {
-        LcdPixel(x + xc, y + yc, mode);
-        LcdPixel(x + xc, y - yc, mode);
-        LcdPixel(x - xc, y + yc, mode);
-        LcdPixel(x - xc, y - yc, mode);
-        LcdPixel(x + yc, y + xc, mode);
-        LcdPixel(x + yc, y - xc, mode);
-        LcdPixel(x - yc, y + xc, mode);
-        LcdPixel(x - yc, y - xc, mode);
-        if (p < 0) p += (xc++ << 2) + 6;
-            else p += ((xc++ - yc--)<<2) + 10;
+        if ( toCache )
+            memcpy( &LcdCache[ bank * LCD_X_RES + area[0] ], buf, width );
+        else
+            memcpy( buf, &LcdCache[ bank * LCD_X_RES + area[0] ], width );
     }
+}
 
-    //    
-    UpdateLcd = TRUE;
+#endif  /*  LCD_SPRITES */
+
+
+
+#ifdef LCD_CONSOLE
+
+/*
+ *                    :  LcdConsoleClear
+ *               :           .
+ *                             
+ * ()           :  
+ *   :  
+ */
+void LcdConsoleClear ( void )
+{
+    memset( ConsoleChars, ' ', sizeof( ConsoleChars ) );
+    memset( ConsoleAttrs, ATTR_NORMAL, sizeof( ConsoleAttrs ) );
+
+    LcdConsoleTouch();
+
+    ConsoleX    = 0;
+    ConsoleY    = 0;
+    ConsoleAttr = ATTR_NORMAL;
+}
+
+
+
+/*
+ *                    :  LcdConsoleGotoXY
+ *               :       x,y
+ * ()           :  x,y ->  . : 0,0 .. LCD_CONSOLE_COLS - 1, LCD_CONSOLE_ROWS - 1
+ *   :      n3310.h
+ */
+byte LcdConsoleGotoXY ( byte x, byte y )
+{
+    if ( x >= LCD_CONSOLE_COLS || y >= LCD_CONSOLE_ROWS ) return OUT_OF_BORDER;
+
+    ConsoleX = x;
+    ConsoleY = y;
     return OK;
 }
 
 
+
 /*
- *                    :  LcdSingleBar
- *               :     
- * ()           :  baseX  ->   x (  )
- *                          baseY  ->   y (  )
- *                          height ->  ( )
- *                          width  ->  ( )
- *                          mode   -> Off, On  Xor.  enum  n3310.h
- *   :      n3310lcd.h
+ *                    :  LcdConsoleSetAttr
+ *               :      
+ * ()           :  attr ->  .  enum LcdAttr  n3310.h
+ *   :  
  */
-byte LcdSingleBar ( byte baseX, byte baseY, byte height, byte width, LcdPixelMode mode )
+void LcdConsoleSetAttr ( byte attr )
 {
-    byte tmpIdxX,tmpIdxY,tmp;
+    ConsoleAttr = attr;
+}
 
-    byte response;
 
-    //  
-    if ( ( baseX >= LCD_X_RES) || ( baseY >= LCD_Y_RES) ) return OUT_OF_BORDER;
 
-    if ( height > baseY )
-        tmp = 0;
-    else
-        tmp = baseY - height + 1;
+/*
+ *                    :  LcdConsoleChr
+ *               :         .     ,
+ *                             ,      
+ * ()           :  ch -> 
+ *   :  OK_WITH_WRAP,        ,  OK
+ */
+byte LcdConsoleChr ( byte ch )
+{
+    if ( ConsoleChars[ ConsoleY ][ ConsoleX ] != ch || ConsoleAttrs[ ConsoleY ][ ConsoleX ] != ConsoleAttr )
+    {
+        ConsoleChars[ ConsoleY ][ ConsoleX ] = ch;
+        ConsoleAttrs[ ConsoleY ][ ConsoleX ] = ConsoleAttr;
+        ConsoleDirty[ ConsoleY ] |= 1 << ConsoleX;
+    }
+
+    if ( ++ConsoleX < LCD_CONSOLE_COLS ) return OK;
 
-    //  
-    for ( tmpIdxY = tmp; tmpIdxY <= baseY; tmpIdxY++ )
+    ConsoleX = 0;
+
+    if ( ++ConsoleY < LCD_CONSOLE_ROWS ) return OK;
+
+    ConsoleY = 0;
+    return OK_WITH_WRAP;
+}
+
+
+
+/*
+ *                    :  LcdConsoleStr
+ *               :       RAM ( LcdConsoleChr)
+ * ()           :  dataArray -> 
+ *   :  OK_WITH_WRAP,          ,  OK
+ */
+byte LcdConsoleStr ( const byte dataArray[] )
+{
+    byte response = OK;
+
+    while ( *dataArray )
     {
-        for ( tmpIdxX = baseX; tmpIdxX < (baseX + width); tmpIdxX++ )
-        {
-            response = LcdPixel( tmpIdxX, tmpIdxY, mode );
-            if(response)
-                return response;
+        if ( LcdConsoleChr( *dataArray++ ) == OK_WITH_WRAP ) response = OK_WITH_WRAP;
+    }
 
-        }
+    return response;
+}
+
+
+
+/*
+ *                    :  LcdConsoleFStr
+ *               :       Flash ROM ( LcdConsoleChr)
+ * ()           :  dataPtr ->   
+ *   :  OK_WITH_WRAP,          ,  OK
+ */
+byte LcdConsoleFStr ( const byte *dataPtr )
+{
+    byte c;
+    byte response = OK;
+
+    for ( c = pgm_read_byte( dataPtr ); c; c = pgm_read_byte( ++dataPtr ) )
+    {
+        if ( LcdConsoleChr( c ) == OK_WITH_WRAP ) response = OK_WITH_WRAP;
     }
 
-    //    
-    UpdateLcd = TRUE;
-    return OK;
+    return response;
 }
 
 
 
 /*
- *                    :  LcdBars
- *               :      (  PIXEL_ON)
- * ()           :  data[]     ->    
- *                          numbBars   ->  
- *                          width      ->  ( )
- *                          multiplier ->   
- *   :      n3310lcd.h
- *             :     EMPTY_SPACE_BARS, BAR_X, BAR_Y  n3310.h
- *                 :  byte example[5] = {1, 2, 3, 4, 5};
- *                          LcdBars(example, 5, 3, 2);
+ *                    :  LcdConsoleFlush
+ *               :        ,   
+ *                            LcdUpdate.       ,  
+ *                             2    6  ,    
+ *                              3   (  LcdUpdate).
+ *                               (    LCD_DOUBLE_BUFFER), 
+ *                           LcdUpdate   .
+ *                              :      ,
+ *                                  
+ * ()           :  
+ *   :  
  */
-byte LcdBars ( byte data[], byte numbBars, byte width, byte multiplier )
+void LcdConsoleFlush ( void )
 {
-    byte b;
-    byte tmpIdx = 0;
-    byte response;
+    byte row, col, first;
+    byte sent = FALSE;
+    int  lo;
 
-    for ( b = 0;  b < numbBars ; b++ )
+    //     ,    
+    LcdWait();
+
+    for ( row = 0; row < LCD_CONSOLE_ROWS; row++ )
     {
-        //     
-        if ( tmpIdx > LCD_X_RES - 1 ) return OUT_OF_BORDER;
+        col = 0;
 
-        //   x
-        tmpIdx = ((width + EMPTY_SPACE_BARS) * b) + BAR_X;
+        while ( ConsoleDirty[ row ] )
+        {
+            //      
+            while ( !( ConsoleDirty[ row ] & ( 1 << col ) ) ) col++;
+
+            first = col;
+
+            while ( col < LCD_CONSOLE_COLS && ( ConsoleDirty[ row ] & ( 1 << col ) ) )
+            {
+                LcdConsoleCell( row, col );
+                ConsoleDirty[ row ] &= ~( 1 << col );
+                col++;
+            }
+
+            if ( !sent )
+            {
+                //     
+                LcdTrBegin();
+                sent = TRUE;
+            }
 
-        //   
-        response = LcdSingleBar( tmpIdx, BAR_Y, data[b] * multiplier, width, PIXEL_ON);
-        if(response == OUT_OF_BORDER)
-            return response;
+            lo = row * LCD_X_RES + first * 6;
+            LcdFlush( lo, lo + ( col - first ) * 6 - 1 );
+        }
     }
 
-    //    
-    UpdateLcd = TRUE;
-    return OK;
+    if ( !sent ) return;
 
+#ifdef CHINA_LCD
+    LcdSend( 0x21, LCD_CMD );    //    
+    LcdSend( 0x45, LCD_CMD );    //    5   ( LcdUpdate)
+    LcdSend( 0x20, LCD_CMD );    //       
+#endif
+
+    LcdTrEnd();
 }
 
 
 
 /*
- *                    :  LcdRect
- *               :    
- * ()           :  x1    ->   x   
- *                          y1    ->   y   
- *                          x2    ->   x   
- *                          y2    ->   y   
- *                          mode  -> Off, On  Xor.  enum  n3310.h
- *   :      n3310lcd.h
+ *                    :  LcdConsoleCell
+ *               :         (   )
+ * ()           :  row ->  
+ *                          col ->  
+ *   :  
  */
-byte LcdRect ( byte x1, byte y1, byte x2, byte y2, LcdPixelMode mode )
+static void LcdConsoleCell ( byte row, byte col )
 {
-    byte tmpIdx;
+    const byte *glyph;
+    byte        i, w, data, attr;
+    int         index = row * LCD_X_RES + col * 6;
 
-    //  
-    if ( ( x1 >= LCD_X_RES) ||  ( x2 >= LCD_X_RES) || ( y1 >= LCD_Y_RES) || ( y2 >= LCD_Y_RES) )
-        return OUT_OF_BORDER;
+    glyph = LcdFontGlyph( &Font5x7, ConsoleChars[ row ][ col ], &w );
+    attr  = ConsoleAttrs[ row ][ col ];
 
-    if ( ( x2 > x1 ) && ( y2 > y1 ) )
+    for ( i = 0; i < 6; i++, index++ )
     {
-        //   
-        for ( tmpIdx = x1; tmpIdx <= x2; tmpIdx++ )
-        {
-            LcdPixel( tmpIdx, y1, mode );
-            LcdPixel( tmpIdx, y2, mode );
-        }
+        //    1..7 ,   -   
+        data = ( i < 5 ) ? pgm_read_byte( glyph + i ) << 1 : 0x00;
 
-        //   
-        for ( tmpIdx = y1; tmpIdx <= y2; tmpIdx++ )
-        {
-            LcdPixel( x1, tmpIdx, mode );
-            LcdPixel( x2, tmpIdx, mode );
-        }
+        if ( attr & ATTR_UNDERLINE ) data |= 0x80;
+        if ( attr & ATTR_INVERSE )   data = ~data;
 
-        //    
-        UpdateLcd = TRUE;
+        LcdCache[ index ] = data;
+        LcdFront[ index ] = data;
     }
-    return OK;
 }
 
 
 
 /*
- *                    :  LcdImage
- *               :        Flash ROM
- * ()           :     
+ *                    :  LcdConsoleTouch
+ *               :      
+ * ()           :  
  *   :  
  */
-void LcdImage ( const byte *imageData )
+static void LcdConsoleTouch ( void )
 {
-//    //   
-//    LcdCacheIdx = 0;
-//    //   
-//    for ( LcdCacheIdx = 0; LcdCacheIdx < LCD_CACHE_SIZE; LcdCacheIdx++ )
-//    {
-//        //      
-//        LcdCache[LcdCacheIdx] = pgm_read_byte( imageData++ );
-//    }
-    
-    //   Jakub Lasinski (March 14 2009)
-    memcpy_P( LcdCache, imageData, LCD_CACHE_SIZE );  //     ,       
-    
-    //      
-    LoWaterMark = 0;
-    HiWaterMark = LCD_CACHE_SIZE - 1;
+    byte row;
 
-    //    
-    UpdateLcd = TRUE;
+    for ( row = 0; row < LCD_CONSOLE_ROWS; row++ ) ConsoleDirty[ row ] = ( 1 << LCD_CONSOLE_COLS ) - 1;
 }
+
+#endif  /*  LCD_CONSOLE */
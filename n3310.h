@@ -19,11 +19,63 @@
 #ifndef _N3310_H_
 #define _N3310_H_
 
+#ifdef __AVR__
+    #include <avr/io.h>
+    #include <avr/pgmspace.h>
+#else
+    //    (   ): Flash ROM   
+    #include <string.h>
+    #define PROGMEM
+    #define PSTR(s)                (s)
+    #define pgm_read_byte(addr)    ( *(const unsigned char *)(addr) )
+    #define pgm_read_word(addr)    ( *(const unsigned int *)(addr) )
+    #define memcpy_P               memcpy
+#endif
+
 //   ,    
 #define CHINA_LCD
 
+//   ,  LcdUpdate   ,      .
+//   LCD_CACHE_SIZE     (   ATmega8,    2    )
+// #define LCD_SHADOW
+
+//      :    ,   
+// ( LcdFlip).    LCD_CACHE_SIZE  
+// #define LCD_DOUBLE_BUFFER
+
+//   ,    (LcdSpriteShow, LcdSpriteMove, LcdSpriteHide):
+//   ,          .
+//  -  ,   LCD_SPRITE_MAX_W * 3 + 11   (   16).
+//     ,      
+// #define LCD_SPRITES                4
+#define LCD_SPRITE_MAX_W           16    //   
+#define LCD_SPRITE_MAX_H           16    //   
+
+//   ,     (LcdConsoleChr, LcdConsoleFlush  .):
+//  6x8       . LcdConsoleFlush   
+//   :   - 8   ,    (CHINA_LCD) 11,  
+//     3  .  2 * 14 * 6 + 15  .
+//   LCD_SPRITES  :        ,  
+// #define LCD_CONSOLE
+
+// ,       LCD (  n3310_*.c)
+#define LCD_TR_HWSPI               1     //  SPI AVR (n3310_spi.c)
+#define LCD_TR_SIM                 2     //   PCD8544     (n3310_sim.c)
+#define LCD_TR_SOFT                3     //  SPI    LCD_PORT (n3310_soft.c)
+#define LCD_TR_USART               4     // USART0   SPI master, ATmega48/88/168/328 (n3310_usart.c)
+#define LCD_TR_LINUX               5     // spidev  GPIO chardev Linux,    (n3310_linux.c)
+
+#ifndef LCD_TRANSPORT
+    #ifdef __AVR__
+        #define LCD_TRANSPORT      LCD_TR_HWSPI
+    #else
+        #define LCD_TRANSPORT      LCD_TR_SIM
+    #endif
+#endif
+
 //     LCD (    ATmega8)
-//    SPI,      -   SPI )
+//   LCD_TR_HWSPI SDIN  SCLK      SPI,
+//  LCD_TR_SOFT      ,  LCD_TR_USART -  USART0 ( )
 #define LCD_PORT                   PORTB
 #define LCD_DDR                    DDRB
 
@@ -34,6 +86,30 @@
 #define LCD_RST_PIN                PB4
 #define SPI_CLK_PIN                PB5   // SCLK     SCK  SPI
 
+//      SCK  SPI: 2, 4, 8, 16, 32, 64  128
+// ( 2, 8  32  SPI2X). PCD8544  SCK   4 
+#define LCD_SPI_DIV                4
+
+//  USART0   SPI master ( LCD_TR_USART,   ATmega48/88/168/328)
+#define USART_DDR                  DDRD
+#define USART_XCK_PIN              PD4   // SCLK 
+#define USART_TXD_PIN              PD1   // SDIN 
+
+//  SCK   USART SPI master: F_CPU / ( 2 * ( LCD_USART_UBRR + 1 ) )
+#define LCD_USART_UBRR             0
+
+//  Linux ( LCD_TR_LINUX). SCE    CS  spidev,
+// DC  RST -   GPIO     gpiochip
+#define LCD_LINUX_SPIDEV           "/dev/spidev0.0"
+#define LCD_LINUX_GPIOCHIP         "/dev/gpiochip0"
+#define LCD_LINUX_DC_LINE          24
+#define LCD_LINUX_RST_LINE         25
+#define LCD_LINUX_SPI_HZ           4000000   //  SCLK, PCD8544    4 
+
+//   ,   LCD_TR_LINUX   spidev  gpiochip
+//         n3310_sim.c (  )
+// #define LCD_LINUX_FAKE
+
 //    
 #define LCD_X_RES                  84    //   
 #define LCD_Y_RES                  48    //   
@@ -46,6 +122,33 @@
 //   ( 84 * 48 ) / 8 = 504 
 #define LCD_CACHE_SIZE             ( ( LCD_X_RES * LCD_Y_RES ) / 8 )
 
+//   (  8 )  
+#define LCD_BANKS                  ( LCD_Y_RES / 8 )
+
+//      6x8 ( LCD_CONSOLE)
+#define LCD_CONSOLE_COLS           ( LCD_X_RES / 6 )
+#define LCD_CONSOLE_ROWS           ( LCD_Y_RES / 8 )
+
+//       ( X  Y)    .
+// LcdUpdate     ,    
+#define LCD_ADDR_COST              2
+
+//      LcdFillPolygon.     ,
+//  14   .    ,     7   8
+#define LCD_POLY_MAX_EDGES         8
+
+//     LcdFloodFill,  4    (    ).
+//    ,    
+#define LCD_FLOOD_STACK            24
+
+//   ,  LcdFloodPeak     
+//    LcdFloodFill (  LCD_FLOOD_STACK,  bench/flood.c)
+// #define LCD_FLOOD_STATS
+
+//     ( LcdSetFont).   FONT_4X  
+//     , LCD_FONT_MAX_H / 2 
+#define LCD_FONT_MAX_H             32
+
 #define FALSE                      0
 #define TRUE                       1
 
@@ -53,6 +156,8 @@
 #define OK                         0   //  
 #define OUT_OF_BORDER              1   //    
 #define OK_WITH_WRAP               2   //    (       )
+#define OUT_OF_MEMORY              3   //    ,      
+                                       // ( LCD_POLY_MAX_EDGES, LCD_FLOOD_STACK  LCD_FONT_MAX_H)
 
 typedef unsigned char              byte;
 
@@ -74,27 +179,127 @@ typedef enum
 
 typedef enum
 {
-    FONT_1X = 1,      //    5x7
-    FONT_2X = 2       //   
+    FONT_1X = 1,      //   
+    FONT_2X = 2,      //  
+    FONT_3X = 3,      //  
+    FONT_4X = 4       //  
 
 } LcdFontSize;
 
+typedef enum
+{
+    ROP_COPY   = 0,   //     
+    ROP_OR     = 1,   //  ,   
+    ROP_AND    = 2,   //  ,   
+    ROP_XOR    = 3,   //  ,   
+    ROP_ANDNOT = 4    //  ,   
+
+} LcdRop;
+
+typedef enum
+{
+    ATTR_NORMAL    = 0,   //  
+    ATTR_INVERSE   = 1,   //     
+    ATTR_UNDERLINE = 2    //  (  )
+
+} LcdAttr;
+
+//  ( )
+typedef struct
+{
+    int  x;
+    int  y;
+
+} LcdPoint;
+
+//     ( LcdFont)
+typedef struct
+{
+    byte  first;   //   
+    byte  last;    //   
+    byte  glyph;   //    first,       
+
+} LcdFontRange;
+
+//   LcdSetFont.     ,  ranges, offsets  data -  Flash ROM.
+//  g    offsets[g]  offsets[g + 1] - 1,    (offsets = NULL)
+//  g * width  g * width + width - 1.     LcdFBlit    
+// ,     ( height + 7 ) / 8:     
+typedef struct
+{
+    byte                 height;       //    ,  LCD_FONT_MAX_H
+    byte                 top;          //    ,    top + height
+    byte                 width;        //    
+    byte                 spacing;      //     
+    byte                 missing;      //   ,    
+    byte                 rangeCount;   //  
+    const LcdFontRange  *ranges;       //  
+    const unsigned int  *offsets;      //           NULL
+    const byte          *data;         //  
+
+} LcdFont;
+
+// ,     
+typedef void ( *LcdCallback )( void );
+
 //  ,     n3310lcd.c
 void LcdInit       ( void );   // 
 void LcdClear      ( void );   //  
 void LcdUpdate     ( void );   //     
+void LcdUpdateAsync( LcdCallback done );   //       
+byte LcdBusy       ( void );   //    
+void LcdFlip       ( void );   //     
 void LcdImage      ( const byte *imageData );   //      Flash ROM
+byte LcdBlit       ( const byte *src, byte w, byte h, int x, int y, LcdRop rop, const byte *mask );   //    RAM   
+byte LcdFBlit      ( const byte *src, byte w, byte h, int x, int y, LcdRop rop, const byte *mask );   //    Flash ROM   
+#ifdef LCD_SPRITES
+byte LcdSpriteShow ( byte id, const byte *image, const byte *mask, byte w, byte h, int x, int y );   //  
+byte LcdSpriteMove ( byte id, int x, int y );   //  
+void LcdSpriteHide ( byte id );   //  
+#endif
 void LcdContrast   ( byte contrast );   //   
+byte LcdSetClip    ( int x1, int y1, int x2, int y2 );   //   
+void LcdSetOrigin  ( int x, int y );   //   
 byte LcdGotoXYFont ( byte x, byte y );   //     x,y
+byte LcdGotoXY     ( int x, int y );   //     x,y
+void LcdSetTextRop ( LcdRop rop );   //   
+byte LcdSetFont    ( const LcdFont *font );   //   (NULL - )
+int  LcdMeasureString ( LcdFontSize size, const byte dataArray[] );   //    RAM
+int  LcdFMeasureString( LcdFontSize size, const byte *dataPtr );   //    Flash ROM
 byte LcdChr        ( LcdFontSize size, byte ch );   //     
 byte LcdStr        ( LcdFontSize size, byte dataArray[] );   //     RAM
 byte LcdFStr       ( LcdFontSize size, const byte *dataPtr );   //     Flash ROM
-byte LcdPixel      ( byte x, byte y, LcdPixelMode mode );   // 
-byte LcdLine       ( byte x1, byte y1, byte x2, byte y2, LcdPixelMode mode );   // 
-byte LcdCircle     ( byte x, byte y, byte radius, LcdPixelMode mode);   // 
-byte LcdRect       ( byte x1, byte y1, byte x2, byte y2, LcdPixelMode mode );   // 
-byte LcdSingleBar  ( byte baseX, byte baseY, byte height, byte width, LcdPixelMode mode );   //  
+byte LcdPixel      ( int x, int y, LcdPixelMode mode );   // 
+byte LcdLine       ( int x1, int y1, int x2, int y2, LcdPixelMode mode );   //  (   -8191..8191)
+byte LcdHLine      ( int x1, int x2, int y, LcdPixelMode mode );   //  
+byte LcdVLine      ( int x, int y1, int y2, LcdPixelMode mode );   //  
+byte LcdThickLine  ( int x1, int y1, int x2, int y2, byte width, LcdPixelMode mode );   //   width
+byte LcdCircle     ( int x, int y, byte radius, LcdPixelMode mode );   // 
+byte LcdFillCircle ( int x, int y, byte radius, LcdPixelMode mode );   // 
+byte LcdEllipse    ( int x, int y, byte rx, byte ry, LcdPixelMode mode );   // 
+byte LcdFillEllipse( int x, int y, byte rx, byte ry, LcdPixelMode mode );   //  
+byte LcdArc        ( int x, int y, byte radius, int startAngle, int endAngle, LcdPixelMode mode );   //  
+byte LcdRect       ( int x1, int y1, int x2, int y2, LcdPixelMode mode );   // 
+byte LcdFillRect   ( int x1, int y1, int x2, int y2, LcdPixelMode mode );   //  
+byte LcdRoundRect  ( int x1, int y1, int x2, int y2, byte radius, LcdPixelMode mode );   //    
+byte LcdFillRoundRect( int x1, int y1, int x2, int y2, byte radius, LcdPixelMode mode );   // ,   
+byte LcdFillTriangle ( int x1, int y1, int x2, int y2, int x3, int y3, LcdPixelMode mode );   //  
+byte LcdFillPolygon  ( const LcdPoint *points, byte count, LcdPixelMode mode );   //  
+byte LcdFloodFill  ( int x, int y, LcdPixelMode mode );   //  
+#ifdef LCD_FLOOD_STATS
+byte LcdFloodPeak  ( void );   //     
+#endif
+byte LcdSingleBar  ( int baseX, int baseY, byte height, byte width, LcdPixelMode mode );   //  
 byte LcdBars       ( byte data[], byte numbBars, byte width, byte multiplier );   // 
+#ifdef LCD_CONSOLE
+void LcdConsoleClear  ( void );   //  
+byte LcdConsoleGotoXY ( byte x, byte y );   //      x,y
+void LcdConsoleSetAttr( byte attr );   //    ( LcdAttr)
+byte LcdConsoleChr    ( byte ch );   //    
+byte LcdConsoleStr    ( const byte dataArray[] );   //   RAM
+byte LcdConsoleFStr   ( const byte *dataPtr );   //   Flash ROM
+void LcdConsoleFlush  ( void );   //      
+#endif
 
 
 
@@ -0,0 +1,190 @@
+#!/usr/bin/env python3
+#
+# Имя          :  n3310_digits.py
+#
+# Описание     :  Генератор n3310_digits.h: крупные цифры высотой 16, 24 и 32 точки для LcdSetFont
+#                 в двух наборах - в стиле семисегментного индикатора и жирные, со сплошными
+#                 углами и более толстыми штрихами. Глифы сразу лежат в формате LcdFBlit
+#                 (банками), поэтому при выводе с границы банка они копируются в кэш целыми
+#                 байтами, без растягивания и сдвига.
+#                 Запуск: python3 n3310_digits.py > n3310_digits.h
+#
+# Автор        :  XANDER
+# Веб-страница :  http://we.easyelectronics.ru/profile/XANDER/
+#
+# Лицензия     :  GPL v3.0
+
+import sys
+
+# Шрифты: имя без высоты, высота, ширина цифры, толщина сегмента, пустые столбцы после символа
+# и сплошные углы (жирный набор: сегменты сходятся в углах, а не обрываются на точку раньше)
+SETS = ( ( 'FontDigits',     16,  8, 2, 2, False ),
+         ( 'FontDigits',     24, 12, 3, 3, False ),
+         ( 'FontDigits',     32, 16, 4, 4, False ),
+         ( 'FontDigitsBold', 16, 10, 3, 2, True ),
+         ( 'FontDigitsBold', 24, 15, 5, 3, True ),
+         ( 'FontDigitsBold', 32, 20, 6, 4, True ) )
+
+# Сегменты цифр: a - верхний, b и c - правые, d - нижний, e и f - левые, g - средний
+SEGMENTS = { '0': 'abcdef', '1': 'bc',   '2': 'abged',   '3': 'abgcd',  '4': 'fgbc',
+             '5': 'afgcd',  '6': 'afgedc', '7': 'abc',   '8': 'abcdefg', '9': 'abcdfg' }
+
+# Символы шрифта по порядку глифов и диапазоны кодов: ( первый, последний, глиф первого )
+CHARS  = '+,-.0123456789: '
+RANGES = ( ( ' ', ' ', 15 ), ( '+', '.', 0 ), ( '0', ':', 4 ) )
+
+
+def glyph ( ch, height, width, thick, bold ):
+    """ Глиф символа ch: список строк точек (0 или 1) """
+    mid = height // 2 - thick // 2       # верхняя строка среднего сегмента
+    w   = thick if ch in '.,:' else width
+    g   = [ [ 0 ] * w for _ in range( height ) ]
+
+    # Отступ горизонтальных сегментов от краев и границы вертикальных: у семисегментного
+    # набора сегменты не касаются друг друга, у жирного перекрываются в углах
+    inset = 0 if bold else 1
+    upper = mid + thick if bold else mid              # конец верхних вертикальных сегментов
+    lower = mid if bold else mid + thick              # начало нижних
+
+    def box ( x0, x1, y0, y1 ):
+        for y in range( y0, y1 ):
+            for x in range( x0, x1 ):
+                g[ y ][ x ] = 1
+
+    segments = SEGMENTS.get( ch, '' )
+
+    if ch in '+-':
+        segments = 'g'
+
+    for s in segments:
+        if s == 'a': box( inset, width - inset, 0, thick )
+        if s == 'g': box( inset, width - inset, mid, mid + thick )
+        if s == 'd': box( inset, width - inset, height - thick, height )
+        if s == 'f': box( 0, thick, inset, upper )
+        if s == 'b': box( width - thick, width, inset, upper )
+        if s == 'e': box( 0, thick, lower, height - inset )
+        if s == 'c': box( width - thick, width, lower, height - inset )
+
+    if ch == '+':
+        # Вертикальная черта той же длины, что и средний сегмент
+        half = ( width - 2 * inset - thick ) // 2
+        x0   = ( width - thick ) // 2
+        box( x0, x0 + thick, mid - half, mid + thick + half )
+
+    if ch in '.,':
+        box( 0, thick, height - thick, height )
+
+    if ch == ':':
+        box( 0, thick, height // 4 - thick // 2, height // 4 - thick // 2 + thick )
+        box( 0, thick, height * 3 // 4 - thick // 2, height * 3 // 4 - thick // 2 + thick )
+
+    return g
+
+
+def banks ( g ):
+    """ Глиф в формате LcdFBlit: банками сверху вниз, в банке байт на столбец, младший бит - верхняя строка """
+    out = []
+
+    for bank in range( ( len( g ) + 7 ) // 8 ):
+        row = []
+
+        for x in range( len( g[ 0 ] ) ):
+            byte = 0
+
+            for bit in range( 8 ):
+                y = bank * 8 + bit
+                if y < len( g ) and g[ y ][ x ]:
+                    byte |= 1 << bit
+
+            row.append( byte )
+
+        out.append( row )
+
+    return out
+
+
+def font ( prefix, height, width, thick, spacing, bold ):
+    name    = '%s%d' % ( prefix, height )
+    lines   = []
+    offsets = [ 0 ]
+
+    lines.append( 'static const byte %sData [] PROGMEM =' % name )
+    lines.append( '{' )
+
+    glyphs = [ banks( glyph( ch, height, width, thick, bold ) ) for ch in CHARS ]
+
+    for i, ( ch, data ) in enumerate( zip( CHARS, glyphs ) ):
+        offsets.append( offsets[ -1 ] + len( data[ 0 ] ) )
+        lines.append( "   // '%s'" % ch )
+
+        for j, row in enumerate( data ):
+            last = ( i == len( CHARS ) - 1 and j == len( data ) - 1 )
+            lines.append( '   ' + ', '.join( '0x%02X' % b for b in row ) + ( '' if last else ',' ) )
+
+    lines.append( '};' )
+    lines.append( '' )
+
+    lines.append( 'static const unsigned int %sOffsets [] PROGMEM =' % name )
+    lines.append( '{' )
+    lines.append( '   ' + ', '.join( '%d' % o for o in offsets ) )
+    lines.append( '};' )
+    lines.append( '' )
+
+    lines.append( 'static const LcdFont %s =' % name )
+    lines.append( '{' )
+    lines.append( '    %d, 0, 0, %d, %d, %d, FontDigitsRanges, %sOffsets, %sData'
+                  % ( height, spacing, CHARS.index( ' ' ), len( RANGES ), name, name ) )
+    lines.append( '};' )
+
+    return '\n'.join( lines )
+
+
+def main ():
+    out = []
+
+    out.append( '''/*
+ * Имя          :  n3310_digits.h
+ *
+ * Описание     :  Крупные цифры для LcdSetFont высотой 16, 24 и 32 точки в двух наборах:
+ *                 FontDigits16, FontDigits24, FontDigits32             - в стиле семисегментного индикатора,
+ *                 FontDigitsBold16, FontDigitsBold24, FontDigitsBold32 - жирные, со сплошными углами.
+ *                 0-9, знаки '+' и '-', десятичная точка (и запятая), двоеточие и пробел шириной с цифру.
+ *                 Все цифры одной ширины, поэтому показания не прыгают при смене значения.
+ *                 Глифы лежат банками (формат LcdFBlit): если строка текста начинается с границы банка
+ *                 (y кратен 8) и операция ROP_COPY, банки глифа копируются в кэш целиком, без сдвига.
+ *                 Таблицы объявлены static, во Flash ROM попадают только используемые шрифты.
+ *
+ *                 Файл создан n3310_digits.py, правьте генератор, а не этот файл.
+ *
+ * Автор        :  XANDER
+ * Веб-страница :  http://we.easyelectronics.ru/profile/XANDER/
+ *
+ * Лицензия     :  GPL v3.0
+ *
+ * Компилятор   :  WinAVR, GCC for AVR platform
+ */
+
+#ifndef _N3310_DIGITS_H_
+#define _N3310_DIGITS_H_
+
+#include "n3310.h"
+
+// Диапазоны кодов, общие для всех шрифтов. Вместо отсутствующих символов выводится пробел
+static const LcdFontRange FontDigitsRanges [] PROGMEM =
+{''' )
+
+    out.append( ',\n'.join( "   { '%s', '%s', %2d }" % r for r in RANGES ) )
+    out.append( '};' )
+
+    for f in SETS:
+        out.append( '\n\n\n/*\n * %s, высота %d точек\n */' % ( 'Жирные' if f[ 5 ] else 'Семисегментные', f[ 1 ] ) )
+        out.append( font( *f ) )
+
+    out.append( '\n#endif  /*  _N3310_DIGITS_H_ */' )
+
+    text = '\n'.join( out ) + '\n'
+    sys.stdout.buffer.write( text.encode( 'cp1251' ) )
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,407 @@
+/*
+ *           :  n3310_linux.c
+ *
+ *      :    spidev  GPIO chardev Linux (LCD_TRANSPORT == LCD_TR_LINUX).
+ *                         ,     
+ *                    SPI_IOC_MESSAGE,     DC   
+ *                 .  DC   GPIO      .
+ *                 SCE    spidev (CS),    n3310.h
+ *
+ *         :  XANDER
+ * - :  http://we.easyelectronics.ru/profile/XANDER/
+ *
+ *      :  GPL v3.0
+ *
+ *    :  GCC
+ */
+
+// usleep  unistd.h glibc    ,     -std=c99  -std=c11.
+//      (n3310.h  string.h)
+#ifndef _DEFAULT_SOURCE
+    #define _DEFAULT_SOURCE
+#endif
+
+#include "n3310.h"
+
+#if LCD_TRANSPORT == LCD_TR_LINUX
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/gpio.h>
+#include <linux/spi/spidev.h>
+#include "n3310_tr.h"
+#include "n3310_linux.h"
+
+#ifdef LCD_LINUX_FAKE
+    #include "n3310_sim.h"
+#endif
+
+//   :       
+// (     spidev  , 4096 )
+#define TX_BUF_SIZE                1024
+
+//   
+
+static void LinuxPut   ( const byte *data, int count, LcdCmdData cd );
+static void LinuxFlush ( void );
+static void LinuxGpio  ( byte dc, byte rst );
+static int  RealOpen   ( const char *path, int flags );
+static int  RealIoctl  ( int fd, unsigned long request, void *arg );
+static int  RealClose  ( int fd );
+
+//  
+
+static const LcdLinuxOps  RealOps = { RealOpen, RealIoctl, RealClose };
+
+#ifdef LCD_LINUX_FAKE
+static const LcdLinuxOps *Ops = &LcdSimLinuxOps;
+#else
+static const LcdLinuxOps *Ops = &RealOps;
+#endif
+
+static LcdLinuxStats  Stats;
+
+//  spidev   GPIO (DC  RST)
+static int   SpiFd  = -1;
+static int   LineFd = -1;
+
+//  ,    
+static byte  TxBuf [ TX_BUF_SIZE ];
+static int   TxLen;
+
+//     DC
+static byte  DcState;
+
+//     ( LcdTrStart)
+static byte  InStart;
+static byte  StartMore;
+
+
+
+/*
+ *                    :  LcdLinuxSetOps
+ *               :     open, ioctl  close,   .
+ *                            LcdInit,      .
+ *                          ,    ,    
+ * ()           :  ops ->     NULL  
+ *   :  
+ */
+void LcdLinuxSetOps ( const LcdLinuxOps *ops )
+{
+    if ( SpiFd >= 0 ) Ops->close( SpiFd );
+    if ( LineFd >= 0 ) Ops->close( LineFd );
+
+    Ops    = ops ? ops : &RealOps;
+    SpiFd  = -1;
+    LineFd = -1;
+}
+
+
+
+/*
+ *                    :  LcdLinuxGetStats
+ *               :     
+ * ()           :  
+ *   :    
+ */
+const LcdLinuxStats * LcdLinuxGetStats ( void )
+{
+    return &Stats;
+}
+
+
+
+/*
+ *                    :  LcdLinuxResetStats
+ *               :     
+ * ()           :  
+ *   :  
+ */
+void LcdLinuxResetStats ( void )
+{
+    memset( &Stats, 0x00, sizeof( Stats ) );
+}
+
+
+
+/*
+ *                    :  LcdTrInit
+ *               :   spidev   GPIO (  ),    LCD
+ * ()           :  
+ *   :  
+ */
+void LcdTrInit ( void )
+{
+    struct gpiohandle_request  req;
+    int                        chip;
+    unsigned char              mode = SPI_MODE_0;
+    unsigned char              bits = 8;
+    unsigned int               speed = LCD_LINUX_SPI_HZ;
+
+    if ( SpiFd < 0 )
+    {
+        SpiFd = Ops->open( LCD_LINUX_SPIDEV, O_RDWR );
+
+        // SPI: CPOL->0, CPHA->0,  8 
+        if ( SpiFd < 0
+          || Ops->ioctl( SpiFd, SPI_IOC_WR_MODE, &mode ) < 0
+          || Ops->ioctl( SpiFd, SPI_IOC_WR_BITS_PER_WORD, &bits ) < 0
+          || Ops->ioctl( SpiFd, SPI_IOC_WR_MAX_SPEED_HZ, &speed ) < 0 )
+        {
+            Stats.errors++;
+        }
+    }
+
+    if ( LineFd < 0 )
+    {
+        //  DC  RST   , RST    
+        memset( &req, 0x00, sizeof( req ) );
+        req.lineoffsets[0]    = LCD_LINUX_DC_LINE;
+        req.lineoffsets[1]    = LCD_LINUX_RST_LINE;
+        req.default_values[1] = 1;
+        req.lines             = 2;
+        req.flags             = GPIOHANDLE_REQUEST_OUTPUT;
+        strcpy( req.consumer_label, "n3310" );
+
+        chip = Ops->open( LCD_LINUX_GPIOCHIP, O_RDWR );
+
+        if ( chip < 0 || Ops->ioctl( chip, GPIO_GET_LINEHANDLE_IOCTL, &req ) < 0 )
+        {
+            Stats.errors++;
+        }
+        else
+        {
+            LineFd = req.fd;
+        }
+
+        //        gpiochip
+        if ( chip >= 0 ) Ops->close( chip );
+    }
+
+    TxLen = 0;
+
+    //  reset
+    LinuxGpio( 0, 0 );
+    usleep( 10000 );
+    LinuxGpio( 0, 1 );
+    usleep( 10000 );
+
+    DcState = LCD_CMD;
+}
+
+
+
+/*
+ *                    :  LcdTrBegin
+ *               :   . SCE  spidev    SPI_IOC_MESSAGE
+ * ()           :  
+ *   :  
+ */
+void LcdTrBegin ( void )
+{
+}
+
+
+
+/*
+ *                    :  LcdTrWrite
+ *               :          
+ * ()           :  data  ->   
+ *                          count ->  
+ *                          cd    ->    ( enum  n3310.h)
+ *   :  
+ */
+void LcdTrWrite ( const byte *data, int count, LcdCmdData cd )
+{
+    LinuxPut( data, count, cd );
+}
+
+
+
+/*
+ *                    :  LcdTrEnd
+ *               :   :  ,    
+ * ()           :  
+ *   :  
+ */
+void LcdTrEnd ( void )
+{
+    LinuxFlush();
+}
+
+
+
+/*
+ *                    :  LcdTrStart
+ *               :      ,      ,
+ *                           LcdTrDone    ( ).   LcdUpdateAsync 
+ *                          ,        ,    LcdUpdate
+ * ()           :  data ->   
+ *                          cd   ->    ( enum  n3310.h)
+ *   :  
+ */
+void LcdTrStart ( byte data, LcdCmdData cd )
+{
+    LinuxPut( &data, 1, cd );
+
+    if ( InStart )
+    {
+        //   LcdTrDone:    
+        StartMore = TRUE;
+        return;
+    }
+
+    InStart = TRUE;
+
+    do
+    {
+        StartMore = FALSE;
+        LcdTrDone();
+    }
+    while ( StartMore );
+
+    InStart = FALSE;
+}
+
+
+
+/*
+ *                    :  LcdTrPoll
+ *               :    .     
+ * ()           :  
+ *   :  
+ */
+void LcdTrPoll ( void )
+{
+}
+
+
+
+/*
+ *                    :  LinuxPut
+ *               :      .    DC 
+ *                           ,   
+ * ()           :  data  ->   
+ *                          count ->  
+ *                          cd    ->    ( enum  n3310.h)
+ *   :  
+ */
+static void LinuxPut ( const byte *data, int count, LcdCmdData cd )
+{
+    int n;
+
+    if ( cd != DcState )
+    {
+        LinuxFlush();
+        LinuxGpio( cd, 1 );
+        DcState = cd;
+    }
+
+    while ( count > 0 )
+    {
+        if ( TxLen == TX_BUF_SIZE ) LinuxFlush();
+
+        n = TX_BUF_SIZE - TxLen;
+        if ( n > count ) n = count;
+
+        memcpy( &TxBuf[ TxLen ], data, n );
+        TxLen += n;
+        data  += n;
+        count -= n;
+    }
+}
+
+
+
+/*
+ *                    :  LinuxFlush
+ *               :      SPI_IOC_MESSAGE
+ * ()           :  
+ *   :  
+ */
+static void LinuxFlush ( void )
+{
+    struct spi_ioc_transfer  tr;
+
+    if ( TxLen == 0 ) return;
+
+    memset( &tr, 0x00, sizeof( tr ) );
+    tr.tx_buf        = (unsigned long)TxBuf;
+    tr.len           = TxLen;
+    tr.speed_hz      = LCD_LINUX_SPI_HZ;
+    tr.bits_per_word = 8;
+
+    Stats.spiCalls++;
+    Stats.bytes += TxLen;
+
+    if ( Ops->ioctl( SpiFd, SPI_IOC_MESSAGE( 1 ), &tr ) < 0 ) Stats.errors++;
+
+    TxLen = 0;
+}
+
+
+
+/*
+ *                    :  LinuxGpio
+ *               :      DC  RST
+ * ()           :  dc  ->   DC
+ *                          rst ->   RST
+ *   :  
+ */
+static void LinuxGpio ( byte dc, byte rst )
+{
+    struct gpiohandle_data  data;
+
+    memset( &data, 0x00, sizeof( data ) );
+    data.values[0] = dc;
+    data.values[1] = rst;
+
+    Stats.gpioCalls++;
+
+    if ( Ops->ioctl( LineFd, GPIOHANDLE_SET_LINE_VALUES_IOCTL, &data ) < 0 ) Stats.errors++;
+}
+
+
+
+/*
+ *                    :  RealOpen
+ *               :    open
+ * ()           :  path  ->   
+ *                          flags ->  
+ *   :    -1
+ */
+static int RealOpen ( const char *path, int flags )
+{
+    return open( path, flags );
+}
+
+
+
+/*
+ *                    :  RealIoctl
+ *               :    ioctl
+ * ()           :  fd      -> 
+ *                          request ->  
+ *                          arg     ->  
+ *   :   ioctl
+ */
+static int RealIoctl ( int fd, unsigned long request, void *arg )
+{
+    return ioctl( fd, request, arg );
+}
+
+
+
+/*
+ *                    :  RealClose
+ *               :    close
+ * ()           :  fd -> 
+ *   :  0  -1
+ */
+static int RealClose ( int fd )
+{
+    return close( fd );
+}
+
+#endif  /*  LCD_TRANSPORT == LCD_TR_LINUX */
@@ -0,0 +1,44 @@
+/*
+ *           :  n3310_linux.h
+ *
+ *      :    spidev  GPIO chardev Linux (LCD_TRANSPORT == LCD_TR_LINUX).
+ *                     (LcdLinuxSetOps),    ,
+ *                   ,       LcdUpdate.
+ *
+ *         :  XANDER
+ * - :  http://we.easyelectronics.ru/profile/XANDER/
+ *
+ *      :  GPL v3.0
+ *
+ *    :  GCC
+ */
+
+#ifndef _N3310_LINUX_H_
+#define _N3310_LINUX_H_
+
+#include "n3310.h"
+
+//  ,      
+typedef struct
+{
+    int ( *open )  ( const char *path, int flags );
+    int ( *ioctl ) ( int fd, unsigned long request, void *arg );
+    int ( *close ) ( int fd );
+
+} LcdLinuxOps;
+
+//   
+typedef struct
+{
+    unsigned long  spiCalls;     //   SPI_IOC_MESSAGE
+    unsigned long  gpioCalls;    //   GPIOHANDLE_SET_LINE_VALUES_IOCTL
+    unsigned long  bytes;        //  ,   spidev
+    unsigned long  errors;       //    
+
+} LcdLinuxStats;
+
+void                  LcdLinuxSetOps     ( const LcdLinuxOps *ops );   //    ( LcdInit), NULL - 
+const LcdLinuxStats * LcdLinuxGetStats   ( void );   //   
+void                  LcdLinuxResetStats ( void );   //  ,   LcdUpdate
+
+#endif  /*  _N3310_LINUX_H_ */
@@ -0,0 +1,485 @@
+/*
+ *           :  n3310_sim.c
+ *
+ *      :  -  PCD8544 (LCD_TRANSPORT == LCD_TR_SIM).
+ *                   SPI     ,     
+ *                    X/Y,  /  
+ *                   ,       .
+ *
+ *         :  XANDER
+ * - :  http://we.easyelectronics.ru/profile/XANDER/
+ *
+ *      :  GPL v3.0
+ *
+ *    :  GCC
+ */
+
+#include "n3310.h"
+
+#if LCD_TRANSPORT == LCD_TR_SIM || ( LCD_TRANSPORT == LCD_TR_LINUX && defined( LCD_LINUX_FAKE ) )
+
+#include "n3310_tr.h"
+#include "n3310_sim.h"
+
+#if LCD_TRANSPORT == LCD_TR_LINUX
+    #include <linux/gpio.h>
+    #include <linux/spi/spidev.h>
+
+    //   
+    #define SIM_SPI_FD             100
+    #define SIM_CHIP_FD            101
+    #define SIM_LINE_FD            102
+#endif
+
+//   
+
+#if LCD_TRANSPORT == LCD_TR_LINUX
+static int  SimOpen    ( const char *path, int flags );
+static int  SimIoctl   ( int fd, unsigned long request, void *arg );
+static int  SimClose   ( int fd );
+#endif
+
+static void SimReset   ( void );
+static void SimDc      ( LcdCmdData cd );
+static void SimByte    ( byte data );
+static void SimCmd     ( byte cmd );
+static void SimData    ( byte data );
+
+//  
+
+static LcdSimModel  Sim;
+
+#if LCD_TRANSPORT == LCD_TR_SIM
+
+// ,    LcdTrStart    
+static byte         PendData;
+static byte         Pending;
+
+
+
+/*
+ *                    :  LcdTrInit
+ *               :    :    RES  
+ * ()           :  
+ *   :  
+ */
+void LcdTrInit ( void )
+{
+    SimReset();
+    Pending = FALSE;
+}
+
+
+
+/*
+ *                    :  LcdTrBegin
+ *               :   :     SCE 
+ * ()           :  
+ *   :  
+ */
+void LcdTrBegin ( void )
+{
+    Sim.ce = TRUE;
+    Sim.ceCycles++;
+}
+
+
+
+/*
+ *                    :  LcdTrWrite
+ *               :         
+ * ()           :  data  ->   
+ *                          count ->  
+ *                          cd    ->    ( enum  n3310.h)
+ *   :  
+ */
+void LcdTrWrite ( const byte *data, int count, LcdCmdData cd )
+{
+    Sim.trWrites++;
+    SimDc( cd );
+
+    while ( count-- > 0 )
+    {
+        SimByte( *data++ );
+    }
+}
+
+
+
+/*
+ *                    :  LcdTrEnd
+ *               :   :     SCE 
+ * ()           :  
+ *   :  
+ */
+void LcdTrEnd ( void )
+{
+    Sim.ce = FALSE;
+}
+
+
+
+/*
+ *                    :  LcdTrStart
+ *               :     .    , 
+ *                               ( LcdSimIrq)
+ * ()           :  data ->   
+ *                          cd   ->    ( enum  n3310.h)
+ *   :  
+ */
+void LcdTrStart ( byte data, LcdCmdData cd )
+{
+    SimDc( cd );
+
+    PendData = data;
+    Pending  = TRUE;
+}
+
+
+
+/*
+ *                    :  LcdTrPoll
+ *               :    :    ,   
+ * ()           :  
+ *   :  
+ */
+void LcdTrPoll ( void )
+{
+    LcdSimIrq();
+}
+
+
+
+/*
+ *                    :  LcdSimIrq
+ *               :     : ,  LcdTrStart,
+ *                            ,      LcdTrDone
+ * ()           :  
+ *   :  TRUE       ,  FALSE
+ */
+byte LcdSimIrq ( void )
+{
+    if ( !Pending ) return FALSE;
+
+    Pending = FALSE;
+    SimByte( PendData );
+
+    LcdTrDone();
+    return TRUE;
+}
+
+#else   /*  LCD_TR_LINUX */
+
+const LcdLinuxOps  LcdSimLinuxOps = { SimOpen, SimIoctl, SimClose };
+
+
+
+/*
+ *                    :  SimOpen
+ *               :   open   spidev  gpiochip  n3310.h
+ * ()           :  path  ->   
+ *                          flags ->   ( )
+ *   :      -1
+ */
+static int SimOpen ( const char *path, int flags )
+{
+    (void)flags;
+
+    if ( strcmp( path, LCD_LINUX_SPIDEV ) == 0 ) return SIM_SPI_FD;
+    if ( strcmp( path, LCD_LINUX_GPIOCHIP ) == 0 ) return SIM_CHIP_FD;
+
+    return -1;
+}
+
+
+
+/*
+ *                    :  SimIoctl
+ *               :   ioctl: SPI_IOC_MESSAGE      ,
+ *                            GPIO  DC ,    RST  
+ * ()           :  fd      ->   
+ *                          request ->  
+ *                          arg     ->  
+ *   :  0    , -1   
+ */
+static int SimIoctl ( int fd, unsigned long request, void *arg )
+{
+    struct spi_ioc_transfer    *tr;
+    struct gpiohandle_request  *req;
+    struct gpiohandle_data     *data;
+    const byte                 *tx;
+    unsigned int                n;
+    unsigned int                i;
+    int                         total = 0;
+
+    if ( fd == SIM_SPI_FD )
+    {
+        //  ,       
+        if ( _IOC_TYPE( request ) != SPI_IOC_MAGIC ) return -1;
+        if ( _IOC_NR( request ) != 0 ) return 0;
+
+        // SPI_IOC_MESSAGE( n ):   0,   n * sizeof( spi_ioc_transfer ).
+        //    spidev  CS (SCE) 
+        tr = arg;
+        n  = _IOC_SIZE( request ) / sizeof( *tr );
+
+        Sim.ce = TRUE;
+        Sim.ceCycles++;
+
+        for ( ; n > 0; n--, tr++ )
+        {
+            tx = (const byte *)(unsigned long)tr->tx_buf;
+
+            for ( i = 0; i < tr->len; i++ )
+            {
+                SimByte( tx[i] );
+            }
+
+            total += tr->len;
+        }
+
+        Sim.ce = FALSE;
+        return total;
+    }
+
+    if ( fd == SIM_CHIP_FD && request == GPIO_GET_LINEHANDLE_IOCTL )
+    {
+        req = arg;
+        req->fd = SIM_LINE_FD;
+        return 0;
+    }
+
+    if ( fd == SIM_LINE_FD && request == GPIOHANDLE_SET_LINE_VALUES_IOCTL )
+    {
+        //  0 - DC,  1 - RST ( LcdTrInit  n3310_linux.c)
+        data = arg;
+
+        if ( !data->values[1] )
+            SimReset();
+        else
+            SimDc( data->values[0] ? LCD_DATA : LCD_CMD );
+
+        return 0;
+    }
+
+    return -1;
+}
+
+
+
+/*
+ *                    :  SimClose
+ *               :   close
+ * ()           :  fd ->   
+ *   :  0
+ */
+static int SimClose ( int fd )
+{
+    (void)fd;
+
+    return 0;
+}
+
+#endif  /*  LCD_TRANSPORT == LCD_TR_SIM */
+
+
+
+/*
+ *                    :  LcdSimState
+ *               :      (, , )
+ * ()           :  
+ *   :     
+ */
+const LcdSimModel * LcdSimState ( void )
+{
+    return &Sim;
+}
+
+
+
+/*
+ *                    :  LcdSimResetCounters
+ *               :    ,    LcdUpdate
+ * ()           :  
+ *   :  
+ */
+void LcdSimResetCounters ( void )
+{
+    Sim.cmdBytes   = 0;
+    Sim.dataBytes  = 0;
+    Sim.lostBytes  = 0;
+    Sim.ceCycles   = 0;
+    Sim.dcSwitches = 0;
+    Sim.trWrites   = 0;
+}
+
+
+
+/*
+ *                    :  LcdSimPixel
+ *               :    ,     
+ * ()           :  x,y ->   
+ *   :  1   ,  0
+ */
+byte LcdSimPixel ( byte x, byte y )
+{
+    if ( x >= LCD_X_RES || y >= LCD_Y_RES ) return 0;
+
+    return ( Sim.ram[ y / 8 + SIM_Y_OFFSET ][ x ] >> ( y % 8 ) ) & 0x01;
+}
+
+
+
+/*
+ *                    :  SimReset
+ *               :    :    RES  
+ * ()           :  
+ *   :  
+ */
+static void SimReset ( void )
+{
+    //      ,  
+    memset( &Sim, 0x00, sizeof( Sim ) );
+
+    //      power down,  DC   
+    Sim.powerDown = TRUE;
+    Sim.dc        = 0xFF;
+}
+
+
+
+/*
+ *                    :  SimDc
+ *               :    DC     
+ * ()           :  cd ->    ( enum  n3310.h)
+ *   :  
+ */
+static void SimDc ( LcdCmdData cd )
+{
+    if ( cd == Sim.dc ) return;
+
+    Sim.dc = cd;
+    Sim.dcSwitches++;
+}
+
+
+
+/*
+ *                    :  SimByte
+ *               :     .    , 
+ *                               SCE
+ * ()           :  data ->  
+ *   :  
+ */
+static void SimByte ( byte data )
+{
+    if ( !Sim.ce )
+    {
+        Sim.lostBytes++;
+        return;
+    }
+
+    if ( Sim.dc == LCD_DATA )
+        SimData( data );
+    else
+        SimCmd( data );
+}
+
+
+
+/*
+ *                    :  SimCmd
+ *               :     ,    PCD8544
+ * ()           :  cmd -> 
+ *   :  
+ */
+static void SimCmd ( byte cmd )
+{
+    Sim.cmdBytes++;
+
+    // Function set     : 0 0 1 0 0 PD V H
+    if ( ( cmd & 0xF8 ) == 0x20 )
+    {
+        Sim.powerDown = ( cmd >> 2 ) & 0x01;
+        Sim.vertical  = ( cmd >> 1 ) & 0x01;
+        Sim.extended  = cmd & 0x01;
+        return;
+    }
+
+    if ( !Sim.extended )
+    {
+        //    (H = 0)
+        if ( cmd & 0x80 )
+        {
+            // Set X address
+            Sim.x = ( cmd & 0x7F ) % SIM_X_RES;
+        }
+        else if ( cmd & 0x40 )
+        {
+            // Set Y address
+            Sim.y = ( cmd & 0x3F ) % SIM_BANKS;
+        }
+        else if ( ( cmd & 0xF8 ) == 0x08 )
+        {
+            // Display control: 0 0 0 0 1 D 0 E
+            Sim.display = cmd & 0x05;
+        }
+    }
+    else
+    {
+        //    (H = 1)
+        if ( cmd & 0x80 )
+        {
+            Sim.vop = cmd & 0x7F;
+        }
+        else if ( cmd & 0x40 )
+        {
+            //  ,   
+            Sim.shift = cmd & 0x3F;
+        }
+        else if ( ( cmd & 0xF8 ) == 0x10 )
+        {
+            Sim.bias = cmd & 0x07;
+        }
+        else if ( ( cmd & 0xFC ) == 0x04 )
+        {
+            Sim.tempCoef = cmd & 0x03;
+        }
+    }
+}
+
+
+
+/*
+ *                    :  SimData
+ *               :          
+ * ()           :  data -> 
+ *   :  
+ */
+static void SimData ( byte data )
+{
+    Sim.dataBytes++;
+
+    Sim.ram[ Sim.y ][ Sim.x ] = data;
+
+    if ( !Sim.vertical )
+    {
+        //  :  X,     
+        if ( ++Sim.x >= SIM_X_RES )
+        {
+            Sim.x = 0;
+            if ( ++Sim.y >= SIM_BANKS ) Sim.y = 0;
+        }
+    }
+    else
+    {
+        //  :  Y,     
+        if ( ++Sim.y >= SIM_BANKS )
+        {
+            Sim.y = 0;
+            if ( ++Sim.x >= SIM_X_RES ) Sim.x = 0;
+        }
+    }
+}
+
+#endif  /*  LCD_TRANSPORT == LCD_TR_SIM || LCD_LINUX_FAKE */
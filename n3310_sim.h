@@ -0,0 +1,76 @@
+/*
+ *           :  n3310_sim.h
+ *
+ *      :    PCD8544      (LCD_TRANSPORT == LCD_TR_SIM,
+ *                   LCD_TR_LINUX  LCD_LINUX_FAKE).
+ *                          
+ *                   ,     LcdUpdate.
+ *
+ *         :  XANDER
+ * - :  http://we.easyelectronics.ru/profile/XANDER/
+ *
+ *      :  GPL v3.0
+ *
+ *    :  GCC
+ */
+
+#ifndef _N3310_SIM_H_
+#define _N3310_SIM_H_
+
+#include "n3310.h"
+
+#ifdef CHINA_LCD
+    //    102 x 64 (+  ),       
+    #define SIM_X_RES              102
+    #define SIM_BANKS              9
+    #define SIM_Y_OFFSET           1
+#else
+    #define SIM_X_RES              84
+    #define SIM_BANKS              6
+    #define SIM_Y_OFFSET           0
+#endif
+
+//  
+typedef struct
+{
+    byte           ram [ SIM_BANKS ][ SIM_X_RES ];   //  
+    byte           x;            //   X
+    byte           y;            //   Y ( )
+    byte           extended;     // H = 1:   
+    byte           vertical;     // V = 1:  
+    byte           powerDown;    // PD = 1:  
+    byte           display;      //  D  E  Display control
+    byte           vop;          //  (Vop)
+    byte           tempCoef;     //  
+    byte           bias;         //   (bias)
+    byte           shift;        //   (   )
+    byte           ce;           // TRUE    (  SCE)
+    byte           dc;           //    DC ( LcdCmdData  n3310.h)
+    unsigned long  cmdBytes;     //    
+    unsigned long  dataBytes;    //    
+    unsigned long  lostBytes;    // ,    SCE (   )
+    unsigned long  ceCycles;     //   ( SCE)
+    unsigned long  dcSwitches;   //    DC
+    unsigned long  trWrites;     //   LcdTrWrite (    bench/bus.c)
+
+} LcdSimModel;
+
+const LcdSimModel * LcdSimState         ( void );   //   
+void                LcdSimResetCounters ( void );   //   
+byte                LcdSimPixel         ( byte x, byte y );   //    ,    
+
+#if LCD_TRANSPORT == LCD_TR_SIM
+byte                LcdSimIrq           ( void );   //     
+#endif
+
+#if LCD_TRANSPORT == LCD_TR_LINUX && defined( LCD_LINUX_FAKE )
+
+#include "n3310_linux.h"
+
+//  spidev  gpiochip     LCD_TR_LINUX:
+//  SPI_IOC_MESSAGE -  ,  GPIO  DC   
+extern const LcdLinuxOps  LcdSimLinuxOps;
+
+#endif
+
+#endif  /*  _N3310_SIM_H_ */
@@ -0,0 +1,232 @@
+/*
+ *           :  n3310_soft.c
+ *
+ *      :     SPI (LCD_TRANSPORT == LCD_TR_SOFT).
+ *                 SDIN  SCLK      LCD_PORT (SPI_MOSI_PIN  SPI_CLK_PIN  n3310.h).
+ *                    ,       .
+ *
+ *         :  XANDER
+ * - :  http://we.easyelectronics.ru/profile/XANDER/
+ *
+ *      :  GPL v3.0
+ *
+ *    :  WinAVR, GCC for AVR platform
+ */
+
+#include "n3310.h"
+
+#if LCD_TRANSPORT == LCD_TR_SOFT
+
+#include "n3310_tr.h"
+
+//   :  SDIN,    SCLK (   )
+#define SOFT_BIT(c, n)                                                  \
+    if ( (c) & ( 1 << (n) ) ) LCD_PORT |= _BV( SPI_MOSI_PIN );          \
+    else                      LCD_PORT &= ~( _BV( SPI_MOSI_PIN ) );     \
+    LCD_PORT |= _BV( SPI_CLK_PIN );                                     \
+    LCD_PORT &= ~( _BV( SPI_CLK_PIN ) )
+
+//   
+
+static void SoftByte   ( byte c );
+static void SoftDc     ( LcdCmdData cd );
+static void Delay      ( void );
+
+//  
+
+//     DC (0xFF - )
+static byte  DcState;
+
+//     ( LcdTrStart)
+static byte  InStart;
+static byte  StartMore;
+
+
+
+/*
+ *                    :  LcdTrInit
+ *               :     ,    LCD
+ * ()           :  
+ *   :  
+ */
+void LcdTrInit ( void )
+{
+    // Pull-up     reset 
+    LCD_PORT |= _BV ( LCD_RST_PIN );
+
+    //      
+    LCD_DDR |= _BV( LCD_RST_PIN ) | _BV( LCD_DC_PIN ) | _BV( LCD_CE_PIN ) | _BV( SPI_MOSI_PIN ) | _BV( SPI_CLK_PIN );
+
+    // SCLK    (CPOL = 0)
+    LCD_PORT &= ~( _BV( SPI_CLK_PIN ) );
+
+    //  
+    Delay();
+
+    //  reset
+    LCD_PORT &= ~( _BV( LCD_RST_PIN ) );
+    Delay();
+    LCD_PORT |= _BV ( LCD_RST_PIN );
+
+    //  LCD  -    SCE
+    LCD_PORT |= _BV( LCD_CE_PIN );
+
+    //  DC   
+    DcState = 0xFF;
+}
+
+
+
+/*
+ *                    :  LcdTrBegin
+ *               :   :       
+ * ()           :  
+ *   :  
+ */
+void LcdTrBegin ( void )
+{
+    //    (  )
+    LCD_PORT &= ~( _BV( LCD_CE_PIN ) );
+}
+
+
+
+/*
+ *                    :  LcdTrWrite
+ *               :        
+ * ()           :  data  ->   
+ *                          count ->  
+ *                          cd    ->    ( enum  n3310.h)
+ *   :  
+ */
+void LcdTrWrite ( const byte *data, int count, LcdCmdData cd )
+{
+    SoftDc( cd );
+
+    while ( count-- > 0 )
+    {
+        SoftByte( *data++ );
+    }
+}
+
+
+
+/*
+ *                    :  LcdTrEnd
+ *               :   :   
+ * ()           :  
+ *   :  
+ */
+void LcdTrEnd ( void )
+{
+    //   
+    LCD_PORT |= _BV( LCD_CE_PIN );
+}
+
+
+
+/*
+ *                    :  LcdTrStart
+ *               :     SPI ,    ,  LcdTrDone
+ *                             ( ).   LcdUpdateAsync 
+ *                                  
+ * ()           :  data ->   
+ *                          cd   ->    ( enum  n3310.h)
+ *   :  
+ */
+void LcdTrStart ( byte data, LcdCmdData cd )
+{
+    SoftDc( cd );
+    SoftByte( data );
+
+    if ( InStart )
+    {
+        //   LcdTrDone:    
+        StartMore = TRUE;
+        return;
+    }
+
+    InStart = TRUE;
+
+    do
+    {
+        StartMore = FALSE;
+        LcdTrDone();
+    }
+    while ( StartMore );
+
+    InStart = FALSE;
+}
+
+
+
+/*
+ *                    :  LcdTrPoll
+ *               :    .     
+ * ()           :  
+ *   :  
+ */
+void LcdTrPoll ( void )
+{
+}
+
+
+
+/*
+ *                    :  SoftByte
+ *               :   ,   
+ * ()           :  c ->   
+ *   :  
+ */
+static void SoftByte ( byte c )
+{
+    SOFT_BIT( c, 7 );
+    SOFT_BIT( c, 6 );
+    SOFT_BIT( c, 5 );
+    SOFT_BIT( c, 4 );
+    SOFT_BIT( c, 3 );
+    SOFT_BIT( c, 2 );
+    SOFT_BIT( c, 1 );
+    SOFT_BIT( c, 0 );
+}
+
+
+
+/*
+ *                    :  SoftDc
+ *               :    DC,       
+ * ()           :  cd ->    ( enum  n3310.h)
+ *   :  
+ */
+static void SoftDc ( LcdCmdData cd )
+{
+    if ( cd == DcState ) return;
+
+    if ( cd == LCD_DATA )
+    {
+        LCD_PORT |= _BV( LCD_DC_PIN );
+    }
+    else
+    {
+        LCD_PORT &= ~( _BV( LCD_DC_PIN ) );
+    }
+
+    DcState = cd;
+}
+
+
+
+/*
+ *                    :  Delay
+ *               :       LCD
+ * ()           :  
+ *   :  
+ */
+static void Delay ( void )
+{
+    int i;
+
+    for ( i = -32000; i < 32000; i++ );
+}
+
+#endif  /*  LCD_TRANSPORT == LCD_TR_SOFT */
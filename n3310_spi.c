@@ -0,0 +1,281 @@
+/*
+ *           :  n3310_spi.c
+ *
+ *      :     SPI AVR (LCD_TRANSPORT == LCD_TR_HWSPI).
+ *                    n3310.h
+ *
+ *         :  XANDER
+ * - :  http://we.easyelectronics.ru/profile/XANDER/
+ *
+ *      :  GPL v3.0
+ *
+ *    :  WinAVR, GCC for AVR platform
+ */
+
+#include "n3310.h"
+
+#if LCD_TRANSPORT == LCD_TR_HWSPI
+
+#include <avr/interrupt.h>
+#include "n3310_tr.h"
+
+//  SPR1:SPR0  SPCR  SPI2X  SPSR    LCD_SPI_DIV
+#if   LCD_SPI_DIV == 2
+    #define SPI_SPR                0x00
+    #define SPI_2X                 _BV( SPI2X )
+#elif LCD_SPI_DIV == 4
+    #define SPI_SPR                0x00
+    #define SPI_2X                 0
+#elif LCD_SPI_DIV == 8
+    #define SPI_SPR                _BV( SPR0 )
+    #define SPI_2X                 _BV( SPI2X )
+#elif LCD_SPI_DIV == 16
+    #define SPI_SPR                _BV( SPR0 )
+    #define SPI_2X                 0
+#elif LCD_SPI_DIV == 32
+    #define SPI_SPR                _BV( SPR1 )
+    #define SPI_2X                 _BV( SPI2X )
+#elif LCD_SPI_DIV == 64
+    #define SPI_SPR                _BV( SPR1 )
+    #define SPI_2X                 0
+#elif LCD_SPI_DIV == 128
+    #define SPI_SPR                ( _BV( SPR1 ) | _BV( SPR0 ) )
+    #define SPI_2X                 0
+#else
+    #error "LCD_SPI_DIV:   2, 4, 8, 16, 32, 64, 128"
+#endif
+
+//   
+
+static void SpiDc      ( LcdCmdData cd );
+static void SpiFlush   ( void );
+static void Delay      ( void );
+
+//  
+
+//     DC (0xFF - )
+static byte  DcState;
+
+//   ,     
+static byte  SpiBusy;
+
+
+
+/*
+ *                    :  LcdTrInit
+ *               :      SPI ,    LCD
+ * ()           :  
+ *   :  
+ */
+void LcdTrInit ( void )
+{
+    // Pull-up     reset 
+    LCD_PORT |= _BV ( LCD_RST_PIN );
+
+    //      
+    LCD_DDR |= _BV( LCD_RST_PIN ) | _BV( LCD_DC_PIN ) | _BV( LCD_CE_PIN ) | _BV( SPI_MOSI_PIN ) | _BV( SPI_CLK_PIN );
+
+    //  
+    Delay();
+
+    //  reset
+    LCD_PORT &= ~( _BV( LCD_RST_PIN ) );
+    Delay();
+    LCD_PORT |= _BV ( LCD_RST_PIN );
+
+    //  SPI:
+    //  ,   ,  , CPOL->0, CPHA->0, Clk/LCD_SPI_DIV
+    SPCR = _BV( SPE ) | _BV( MSTR ) | SPI_SPR;
+    SPSR = SPI_2X;
+
+    //  LCD  -    SCE
+    LCD_PORT |= _BV( LCD_CE_PIN );
+
+    //  DC   
+    DcState = 0xFF;
+    SpiBusy = FALSE;
+}
+
+
+
+/*
+ *                    :  LcdTrBegin
+ *               :   :       
+ * ()           :  
+ *   :  
+ */
+void LcdTrBegin ( void )
+{
+    //    (  )
+    LCD_PORT &= ~( _BV( LCD_CE_PIN ) );
+}
+
+
+
+/*
+ *                    :  LcdTrWrite
+ *               :        .  
+ *                               SPDR,    ,  
+ *                                (,  
+ *                           )      
+ * ()           :  data  ->   
+ *                          count ->  
+ *                          cd    ->    ( enum  n3310.h)
+ *   :  
+ */
+void LcdTrWrite ( const byte *data, int count, LcdCmdData cd )
+{
+    byte c;
+
+    // DC        
+    if ( cd != DcState )
+    {
+        SpiFlush();
+        SpiDc( cd );
+    }
+
+    while ( count-- > 0 )
+    {
+        //   ,   
+        c = *data++;
+
+        //     
+        if ( SpiBusy )
+            while ( (SPSR & 0x80) != 0x80 );
+
+        //     .  SPSR   SPIF
+        //   SPDR   
+        SPDR = c;
+        SpiBusy = TRUE;
+    }
+}
+
+
+
+/*
+ *                    :  LcdTrEnd
+ *               :   :   
+ * ()           :  
+ *   :  
+ */
+void LcdTrEnd ( void )
+{
+    //       
+    SpiFlush();
+
+    //   
+    LCD_PORT |= _BV( LCD_CE_PIN );
+}
+
+
+
+/*
+ *                    :  LcdTrStart
+ *               :        SPI   
+ * ()           :  data ->   
+ *                          cd   ->    ( enum  n3310.h)
+ *   :  
+ */
+void LcdTrStart ( byte data, LcdCmdData cd )
+{
+    SpiDc( cd );
+
+    //     .      SPDR:
+    //  SPIF       SPI_STC_vect,      SPDR 
+    //   ,     ( )
+    SPDR = data;
+
+    //    ,   SPI_STC_vect
+    SPCR |= _BV( SPIE );
+}
+
+
+
+/*
+ *                    :  LcdTrPoll
+ *               :    .    ,    
+ *                          (   ,     )
+ * ()           :  
+ *   :  
+ */
+void LcdTrPoll ( void )
+{
+}
+
+
+
+/*
+ *                    :  SPI_STC_vect
+ *               :        SPI
+ */
+ISR( SPI_STC_vect )
+{
+    //  ,      .
+    //   , LcdTrStart   
+    SPCR &= ~( _BV( SPIE ) );
+
+    LcdTrDone();
+}
+
+
+
+/*
+ *                    :  SpiDc
+ *               :    DC,       .
+ *                                 ( SpiFlush)
+ * ()           :  cd ->    ( enum  n3310.h)
+ *   :  
+ */
+static void SpiDc ( LcdCmdData cd )
+{
+    if ( cd == DcState ) return;
+
+    if ( cd == LCD_DATA )
+    {
+        LCD_PORT |= _BV( LCD_DC_PIN );
+    }
+    else
+    {
+        LCD_PORT &= ~( _BV( LCD_DC_PIN ) );
+    }
+
+    DcState = cd;
+}
+
+
+
+/*
+ *                    :  SpiFlush
+ *               :          SPIF
+ * ()           :  
+ *   :  
+ */
+static void SpiFlush ( void )
+{
+    if ( !SpiBusy ) return;
+
+    //   
+    while ( (SPSR & 0x80) != 0x80 );
+
+    //  SPDR  SPSR  SPIF,       (LcdTrStart)
+    (void)SPDR;
+
+    SpiBusy = FALSE;
+}
+
+
+
+/*
+ *                    :  Delay
+ *               :       LCD
+ * ()           :  
+ *   :  
+ */
+static void Delay ( void )
+{
+    int i;
+
+    for ( i = -32000; i < 32000; i++ );
+}
+
+#endif  /*  LCD_TRANSPORT == LCD_TR_HWSPI */
@@ -0,0 +1,36 @@
+/*
+ *           :  n3310_tr.h
+ *
+ *      :      n3310.c   LCD.
+ *                         SPI,     .
+ *                   (n3310_spi.c, n3310_sim.c, ...)   
+ *                   LCD_TRANSPORT  n3310.h
+ *
+ *         :  XANDER
+ * - :  http://we.easyelectronics.ru/profile/XANDER/
+ *
+ *      :  GPL v3.0
+ *
+ *    :  WinAVR, GCC for AVR platform
+ */
+
+#ifndef _N3310_TR_H_
+#define _N3310_TR_H_
+
+#include "n3310.h"
+
+void LcdTrInit  ( void );   //       
+
+//   : CE     LcdTrBegin    LcdTrEnd,
+//  DC        
+void LcdTrBegin ( void );   //   (CE )
+void LcdTrWrite ( const byte *data, int count, LcdCmdData cd );   //  count    
+void LcdTrEnd   ( void );   //      
+
+//    : LcdTrStart    ,
+//     ( )  LcdTrDone,   
+void LcdTrStart ( byte data, LcdCmdData cd );   //    
+void LcdTrPoll  ( void );   //       
+void LcdTrDone  ( void );   //    (  n3310.c)
+
+#endif  /*  _N3310_TR_H_ */
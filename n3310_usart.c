@@ -0,0 +1,260 @@
+/*
+ *           :  n3310_usart.c
+ *
+ *      :    USART0   SPI master (LCD_TRANSPORT == LCD_TR_USART).
+ *                    SPI  USART   :     UDR0,
+ *                    ,         .
+ *                    ATmega48/88/168/328  ,  ATmega8  .
+ *                 SCLK    XCK0, SDIN  TXD0 ( n3310.h)
+ *
+ *         :  XANDER
+ * - :  http://we.easyelectronics.ru/profile/XANDER/
+ *
+ *      :  GPL v3.0
+ *
+ *    :  WinAVR, GCC for AVR platform
+ */
+
+#include "n3310.h"
+
+#if LCD_TRANSPORT == LCD_TR_USART
+
+#include <avr/interrupt.h>
+#include "n3310_tr.h"
+
+//   
+
+static void UsartDc    ( LcdCmdData cd );
+static void UsartFlush ( void );
+static void Delay      ( void );
+
+//  
+
+//     DC (0xFF - )
+static byte  DcState;
+
+//  ,     
+static byte  UsartBusy;
+
+
+
+/*
+ *                    :  LcdTrInit
+ *               :      USART0   SPI master,    LCD
+ * ()           :  
+ *   :  
+ */
+void LcdTrInit ( void )
+{
+    // Pull-up     reset 
+    LCD_PORT |= _BV ( LCD_RST_PIN );
+
+    //      
+    LCD_DDR |= _BV( LCD_RST_PIN ) | _BV( LCD_DC_PIN ) | _BV( LCD_CE_PIN );
+
+    //  
+    Delay();
+
+    //  reset
+    LCD_PORT &= ~( _BV( LCD_RST_PIN ) );
+    Delay();
+    LCD_PORT |= _BV ( LCD_RST_PIN );
+
+    //  LCD  -    SCE
+    LCD_PORT |= _BV( LCD_CE_PIN );
+
+    //  USART   SPI master  :  UBRR0 = 0,
+    // XCK0  ,   ,     
+    UBRR0 = 0;
+    USART_DDR |= _BV( USART_XCK_PIN ) | _BV( USART_TXD_PIN );
+
+    // MSPIM,   , CPOL->0, CPHA->0
+    UCSR0C = _BV( UMSEL01 ) | _BV( UMSEL00 );
+
+    //  ,  
+    UCSR0B = _BV( TXEN0 );
+
+    UBRR0 = LCD_USART_UBRR;
+
+    //  DC   
+    DcState   = 0xFF;
+    UsartBusy = FALSE;
+}
+
+
+
+/*
+ *                    :  LcdTrBegin
+ *               :   :       
+ * ()           :  
+ *   :  
+ */
+void LcdTrBegin ( void )
+{
+    //    (  )
+    LCD_PORT &= ~( _BV( LCD_CE_PIN ) );
+}
+
+
+
+/*
+ *                    :  LcdTrWrite
+ *               :        .
+ *                              ,    
+ * ()           :  data  ->   
+ *                          count ->  
+ *                          cd    ->    ( enum  n3310.h)
+ *   :  
+ */
+void LcdTrWrite ( const byte *data, int count, LcdCmdData cd )
+{
+    byte c;
+
+    // DC          
+    if ( cd != DcState )
+    {
+        UsartFlush();
+        UsartDc( cd );
+    }
+
+    while ( count-- > 0 )
+    {
+        c = *data++;
+
+        //    
+        while ( !( UCSR0A & _BV( UDRE0 ) ) );
+
+        UDR0 = c;
+
+        //         :   
+        //  , TXC0   ,       
+        UCSR0A |= _BV( TXC0 );
+        UsartBusy = TRUE;
+    }
+}
+
+
+
+/*
+ *                    :  LcdTrEnd
+ *               :   :   
+ * ()           :  
+ *   :  
+ */
+void LcdTrEnd ( void )
+{
+    //       
+    UsartFlush();
+
+    //   
+    LCD_PORT |= _BV( LCD_CE_PIN );
+}
+
+
+
+/*
+ *                    :  LcdTrStart
+ *               :        USART   
+ * ()           :  data ->   
+ *                          cd   ->    ( enum  n3310.h)
+ *   :  
+ */
+void LcdTrStart ( byte data, LcdCmdData cd )
+{
+    UsartDc( cd );
+
+    UDR0 = data;
+
+    //        
+    UCSR0A |= _BV( TXC0 );
+
+    //    
+    UCSR0B |= _BV( TXCIE0 );
+}
+
+
+
+/*
+ *                    :  LcdTrPoll
+ *               :    .    ,    
+ *                          (   ,     )
+ * ()           :  
+ *   :  
+ */
+void LcdTrPoll ( void )
+{
+}
+
+
+
+/*
+ *                    :  USART_TX_vect
+ *               :        USART
+ */
+ISR( USART_TX_vect )
+{
+    //  ,      .
+    //   , LcdTrStart   
+    UCSR0B &= ~( _BV( TXCIE0 ) );
+
+    LcdTrDone();
+}
+
+
+
+/*
+ *                    :  UsartDc
+ *               :    DC,       .
+ *                                 ( UsartFlush)
+ * ()           :  cd ->    ( enum  n3310.h)
+ *   :  
+ */
+static void UsartDc ( LcdCmdData cd )
+{
+    if ( cd == DcState ) return;
+
+    if ( cd == LCD_DATA )
+    {
+        LCD_PORT |= _BV( LCD_DC_PIN );
+    }
+    else
+    {
+        LCD_PORT &= ~( _BV( LCD_DC_PIN ) );
+    }
+
+    DcState = cd;
+}
+
+
+
+/*
+ *                    :  UsartFlush
+ *               :  ,        
+ * ()           :  
+ *   :  
+ */
+static void UsartFlush ( void )
+{
+    if ( !UsartBusy ) return;
+
+    while ( !( UCSR0A & _BV( TXC0 ) ) );
+
+    UsartBusy = FALSE;
+}
+
+
+
+/*
+ *                    :  Delay
+ *               :       LCD
+ * ()           :  
+ *   :  
+ */
+static void Delay ( void )
+{
+    int i;
+
+    for ( i = -32000; i < 32000; i++ );
+}
+
+#endif  /*  LCD_TRANSPORT == LCD_TR_USART */